@@ -16,6 +16,7 @@
 
 #include <sst/core/baseComponent.h>
 #include <sst/core/component.h>
+#include <sst/core/componentProfile.h>
 #include <sst/core/subcomponent.h>
 #include <sst/core/unitAlgebra.h>
 #include <sst/core/factory.h>
@@ -101,6 +102,9 @@ BaseComponent::~BaseComponent()
 
 
 TimeConverter* BaseComponent::registerClock( std::string freq, Clock::HandlerBase* handler, bool regAll) {
+    if ( Core::ComponentProfile::get() ) {
+        handler = Core::ComponentProfile::get()->wrapClockHandler(my_info->getID(), handler);
+    }
     TimeConverter* tc = getSimulation()->registerClock(freq, handler, CLOCKPRIORITY);
 
     // if regAll is true set tc as the default for the component and
@@ -120,6 +124,9 @@ TimeConverter* BaseComponent::registerClock( std::string freq, Clock::HandlerBas
 }
 
 TimeConverter* BaseComponent::registerClock( const UnitAlgebra& freq, Clock::HandlerBase* handler, bool regAll) {
+    if ( Core::ComponentProfile::get() ) {
+        handler = Core::ComponentProfile::get()->wrapClockHandler(my_info->getID(), handler);
+    }
     TimeConverter* tc = getSimulation()->registerClock(freq, handler, CLOCKPRIORITY);
 
     // if regAll is true set tc as the default for the component and
@@ -139,6 +146,13 @@ TimeConverter* BaseComponent::registerClock( const UnitAlgebra& freq, Clock::Han
 }
 
 Cycle_t BaseComponent::reregisterClock( TimeConverter* freq, Clock::HandlerBase* handler) {
+    if ( Core::ComponentProfile::get() ) {
+        handler = Core::ComponentProfile::get()->wrapClockHandler(my_info->getID(), handler);
+    }
+    Core::ClockGate* gate = getClockGate(false);
+    if ( gate != NULL && gate->isIdle(handler) ) {
+        return gate->wake(handler);
+    }
     return getSimulation()->reregisterClock(freq, handler, CLOCKPRIORITY);
 }
 
@@ -146,7 +160,35 @@ Cycle_t BaseComponent::getNextClockCycle( TimeConverter* freq ) {
     return getSimulation()->getNextClockCycle(freq, CLOCKPRIORITY);
 }
 
+void BaseComponent::idleClock( TimeConverter* freq, Clock::HandlerBase* handler, Clock::WakeHandlerBase* wake ) {
+    if ( Core::ComponentProfile::get() ) {
+        handler = Core::ComponentProfile::get()->wrapClockHandler(my_info->getID(), handler);
+    }
+    // The handler has run, or would have, up to the cycle before the
+    // clock's next one
+    Cycle_t last_cycle = getSimulation()->getNextClockCycle(freq, CLOCKPRIORITY) - 1;
+    getClockGate(true)->idle(freq, handler, wake, last_cycle);
+}
+
+Core::ClockGate* BaseComponent::getClockGate(bool create) {
+    LinkMap* myLinks = my_info->getLinkMap();
+    if ( NULL == myLinks ) {
+        if ( !create ) return NULL;
+        getSimulation()->getSimulationOutput().fatal(CALL_INFO, 1, "Component %s has no links, so a clock cannot be idled\n",
+                                                     getName().c_str());
+    }
+    return create ? myLinks->createClockGate() : myLinks->getClockGate();
+}
+
 void BaseComponent::unregisterClock(TimeConverter *tc, Clock::HandlerBase* handler) {
+    if ( Core::ComponentProfile::get() ) {
+        handler = Core::ComponentProfile::get()->wrapClockHandler(my_info->getID(), handler);
+    }
+    Core::ClockGate* gate = getClockGate(false);
+    if ( gate != NULL && gate->isIdle(handler) ) {
+        gate->cancel(handler);
+        return;
+    }
     getSimulation()->unregisterClock(tc, handler, CLOCKPRIORITY);
 }
 
@@ -207,6 +249,9 @@ BaseComponent::configureLink(std::string name, TimeConverter* time_base, Event::
     if ( handler == NULL ) {
         tmp->setPolling();
     }
+    else if ( Core::ComponentProfile::get() ) {
+        handler = Core::ComponentProfile::get()->wrapEventHandler(my_info->getID(), tmp, handler);
+    }
     tmp->setFunctor(handler);
     tmp->setDefaultTimeBase(time_base);
 #ifdef __SST_DEBUG_EVENT_TRACKING__
@@ -232,6 +277,9 @@ BaseComponent::configureLink(std::string name, Event::HandlerBase* handler)
     if ( handler == NULL ) {
         tmp->setPolling();
     }
+    else if ( Core::ComponentProfile::get() ) {
+        handler = Core::ComponentProfile::get()->wrapEventHandler(my_info->getID(), tmp, handler);
+    }
     tmp->setFunctor(handler);
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     tmp->setSendingComponentInfo(my_info->getName(), my_info->getType(), name);
@@ -281,10 +329,13 @@ Link* BaseComponent::selfLink( std::string UNUSED(name), Event::HandlerBase* han
 {
     Link* link = new SelfLink();
     link->setLatency(0);
-    link->setFunctor(handler);
     if ( handler == NULL ) {
         link->setPolling();
     }
+    else if ( Core::ComponentProfile::get() ) {
+        handler = Core::ComponentProfile::get()->wrapEventHandler(my_info->getID(), link, handler);
+    }
+    link->setFunctor(handler);
     return link;
 }
 
@@ -44,6 +44,10 @@ class Component;
 class SubComponent;
 class SubComponentSlotInfo_impl;
 
+namespace Core {
+class ClockGate;
+}
+
 class SubComponentSlotInfo {
 
 protected:
@@ -213,6 +217,63 @@ public:
     /** Returns the next Cycle that the TimeConverter would fire */
     Cycle_t getNextClockCycle(TimeConverter *freq);
 
+    /** Stops calling a clock handler until an event arrives on one of
+     * this component's links, at which point the core reregisters the
+     * handler (before the event handler runs) so that it next fires on
+     * the clock's following cycle.  May be called from the clock
+     * handler itself.  A handler still idle when the simulation ends
+     * is deleted by the core, as a registered one would be.
+     *
+     * Only links with an event handler (including self links made by
+     * configureSelfLink()) wake the clock; a component that polls its
+     * links must call reregisterClock() itself, which also wakes an
+     * idle handler.
+     * @param freq Clock the handler is registered on
+     * @param handler Handler to idle
+     * @param wake Optional handler called on waking, with the number
+     * of cycles the clock handler missed.  The core takes ownership.
+     */
+    void idleClock(TimeConverter *freq, Clock::HandlerBase* handler, Clock::WakeHandlerBase* wake = NULL);
+
+    /** Adds this component to the clock group for its type.  Instead
+        of a handler per component, tick is called once per cycle for
+        all the components of type classT on this thread that share the
+        clock (see Clock::Group).  Group ticks are not timed by the
+        component profile, and a group member cannot idle the clock.
+        @param freq Frequency for the clock in SI units
+        @param tick Static function ticking the members of the group.
+        Every member must pass the same function.
+        @param regAll Should this clock period be used as the default
+        time base for all of the links connected to this component
+    */
+    template <typename classT>
+    TimeConverter* registerClockGroup( std::string freq, typename Clock::Group<classT>::BatchTick tick,
+                                       bool regAll = true) {
+        TimeConverter* tc = registerTimeBase(freq, regAll);
+        Clock::Group<classT>* group =
+            static_cast<Clock::Group<classT>*>(getSimulation()->getClockGroup(tc, typeid(classT), CLOCKPRIORITY));
+        if ( group == NULL ) {
+            group = new Clock::Group<classT>(tick);
+            getSimulation()->registerClockGroup(tc, typeid(classT), group, CLOCKPRIORITY);
+        }
+        else if ( group->getTick() != tick ) {
+            Simulation::getSimulationOutput().fatal(CALL_INFO, 1, "Component %s registered a different tick function "
+                                                    "for the clock group of its type\n", getName().c_str());
+        }
+        if ( group->add(static_cast<classT*>(this)) ) {
+            getSimulation()->reregisterClock(tc, group, CLOCKPRIORITY);
+        }
+        return tc;
+    }
+
+    /** Removes this component from the clock group for its type */
+    template <typename classT>
+    void unregisterClockGroup( TimeConverter* tc ) {
+        Clock::Group<classT>* group =
+            static_cast<Clock::Group<classT>*>(getSimulation()->getClockGroup(tc, typeid(classT), CLOCKPRIORITY));
+        if ( group != NULL ) group->remove(static_cast<classT*>(this));
+    }
+
     /** Registers a OneShot event for this component.
         Note: OneShot cannot be canceled, and will always callback after
           the timedelay.
@@ -382,6 +443,8 @@ protected:
 
 private:
     void addSelfLink(std::string name);
+    /** Returns the gate for this component's idle clocks, creating it if create is true */
+    Core::ClockGate* getClockGate(bool create);
 
     template <typename T>
     Statistic<T>* registerStatisticCore(std::string statName, std::string statSubId = "")
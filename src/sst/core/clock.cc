@@ -22,7 +22,9 @@ Clock::Clock( TimeConverter* period, int priority ) :
     Action(),
     currentCycle( 0 ),
     period( period ),
-    scheduled( false )
+    numRemoved( 0 ),
+    scheduled( false ),
+    executing( false )
 {
     setPriority(priority);
 } 
@@ -30,17 +32,28 @@ Clock::Clock( TimeConverter* period, int priority ) :
 
 Clock::~Clock()
 {
-    // Delete all the handlers
+    // Groups are deleted here even if they have left the clock, so
+    // take them out of the handler list first
+    for ( std::map<std::type_index, GroupBase*>::iterator it = groups.begin(); it != groups.end(); ++it ) {
+        HandlerIndex_t::iterator index = handlerIndex.find( it->second );
+        if ( index != handlerIndex.end() ) staticHandlerMap[index->second] = NULL;
+        delete it->second;
+    }
+    groups.clear();
+
+    // Delete all the handlers (removed handlers left NULL entries)
     for ( StaticHandlerMap_t::iterator it = staticHandlerMap.begin(); it != staticHandlerMap.end(); ++it ) {
         delete *it;
     }
     staticHandlerMap.clear();
+    handlerIndex.clear();
 }
 
 
 bool Clock::registerHandler( Clock::HandlerBase* handler )
 {
-    staticHandlerMap.push_back( handler );	
+    handlerIndex.insert( std::make_pair(handler, staticHandlerMap.size()) );
+    staticHandlerMap.push_back( handler );
     if ( !scheduled ) {
         schedule();
     }
@@ -50,19 +63,75 @@ bool Clock::registerHandler( Clock::HandlerBase* handler )
 
 bool Clock::unregisterHandler( Clock::HandlerBase* handler, bool& empty )
 {
+    HandlerIndex_t::iterator iter = handlerIndex.find( handler );
+    if ( iter != handlerIndex.end() ) {
+        size_t index = iter->second;
+        handlerIndex.erase( iter );
+        staticHandlerMap[index] = NULL;
+        numRemoved++;
+        // execute() compacts once it has called the handlers
+        if ( !executing && numRemoved * 2 > staticHandlerMap.size() ) {
+            compact();
+        }
+    }
 
-    StaticHandlerMap_t::iterator iter = staticHandlerMap.begin();
+    empty = handlerIndex.empty();
+
+    return 0;
+}
 
-    for ( ; iter != staticHandlerMap.end(); iter++ ) {
-        if ( *iter == handler ) {
-            staticHandlerMap.erase( iter );
+void
+Clock::removeHandler( size_t index )
+{
+    std::pair<HandlerIndex_t::iterator, HandlerIndex_t::iterator> range =
+        handlerIndex.equal_range( staticHandlerMap[index] );
+    for ( HandlerIndex_t::iterator iter = range.first; iter != range.second; ++iter ) {
+        if ( iter->second == index ) {
+            handlerIndex.erase( iter );
             break;
         }
     }
-  
-    empty = staticHandlerMap.empty();
-    
-    return 0;
+    staticHandlerMap[index] = NULL;
+    numRemoved++;
+}
+
+void
+Clock::compact()
+{
+    // Keeps the handlers in order, so the calling order does not
+    // depend on when compaction happens
+    size_t count = 0;
+    for ( size_t i = 0; i < staticHandlerMap.size(); i++ ) {
+        Clock::HandlerBase* handler = staticHandlerMap[i];
+        if ( handler == NULL ) continue;
+        if ( i != count ) {
+            std::pair<HandlerIndex_t::iterator, HandlerIndex_t::iterator> range = handlerIndex.equal_range( handler );
+            for ( HandlerIndex_t::iterator iter = range.first; iter != range.second; ++iter ) {
+                if ( iter->second == i ) {
+                    iter->second = count;
+                    break;
+                }
+            }
+            staticHandlerMap[count] = handler;
+        }
+        count++;
+    }
+    staticHandlerMap.resize( count );
+    numRemoved = 0;
+}
+
+Clock::GroupBase*
+Clock::getGroup( const std::type_info& type ) const
+{
+    std::map<std::type_index, GroupBase*>::const_iterator it = groups.find( std::type_index(type) );
+    if ( it == groups.end() ) return NULL;
+    return it->second;
+}
+
+void
+Clock::addGroup( const std::type_info& type, GroupBase* group )
+{
+    groups[std::type_index(type)] = group;
 }
 
 Cycle_t
@@ -75,8 +144,10 @@ Clock::getNextCycle()
 void Clock::execute( void ) {
     Simulation *sim = Simulation::getSimulation();
     
-    if ( staticHandlerMap.empty() ) {
+    if ( handlerIndex.empty() ) {
         // std::cout << "Not rescheduling clock" << std::endl;
+        staticHandlerMap.clear();
+        numRemoved = 0;
         scheduled = false;
         return;
     } 
@@ -85,14 +156,22 @@ void Clock::execute( void ) {
     // currentCycle = period->convertFromCoreTime(sim->getCurrentSimCycle());
     currentCycle++;
     
-    StaticHandlerMap_t::iterator sop_iter,start_iter,stop_iter;
-    //bool group = false;	//Scoggin(Jan23,2015) fix unused variable warning in build
-    for ( sop_iter = staticHandlerMap.begin(); sop_iter != staticHandlerMap.end();  ) {
-    	Clock::HandlerBase* handler = *sop_iter;
-    	if ( (*handler)(currentCycle) ) sop_iter = staticHandlerMap.erase(sop_iter);
-    	else ++sop_iter;
-    	// (*handler)(currentCycle);
-    	// ++sop_iter;
+    // Handlers may unregister (themselves or others) or register
+    // handlers while the clock runs, so step through by index.  Only
+    // the handlers present at the start of the tick are called.
+    executing = true;
+    size_t count = staticHandlerMap.size();
+    for ( size_t i = 0; i < count; i++ ) {
+    	Clock::HandlerBase* handler = staticHandlerMap[i];
+    	if ( handler == NULL ) continue;
+    	// A handler that unregistered itself has already been removed
+    	if ( (*handler)(currentCycle) && staticHandlerMap[i] == handler ) {
+            removeHandler(i);
+    	}
+    }
+    executing = false;
+    if ( numRemoved * 2 > staticHandlerMap.size() ) {
+        compact();
     }
     
     next = sim->getCurrentSimCycle() + period->getFactor();
@@ -130,7 +209,7 @@ Clock::print(const std::string& header, Output &out) const
     out.output("%s Clock Activity with period %" PRIu64 " to be delivered at %" PRIu64
                " with priority %d, with %d items on clock list\n",
                header.c_str(), period->getFactor(), getDeliveryTime(), getPriority(),
-               (int)staticHandlerMap.size());
+               (int)handlerIndex.size());
 }
 
 } // namespace SST
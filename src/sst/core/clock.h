@@ -15,7 +15,11 @@
 
 //#include <deque>
 //#include <list>
+#include <map>
+#include <typeindex>
+#include <typeinfo>
 #include <vector>
+#include <unordered_map>
 #include <cinttypes>
 
 #include <sst/core/action.h>
@@ -30,7 +34,9 @@ class TimeConverter;
 /**
  * A Clock class.
  *
- * Calls callback functions (handlers) on a specified period
+ * Calls callback functions (handlers) on a specified period.  Handlers
+ * are called in the order they were registered; a handler that is
+ * unregistered and registered again moves to the end.
  */
 class Clock : public Action
 {
@@ -103,6 +109,196 @@ public:
         }
     };
 
+
+    /** Functor classes called when an idle clock is woken (see
+     * BaseComponent::idleClock()).  The argument is the number of
+     * cycles the clock handler was not called for.
+     */
+    class WakeHandlerBase {
+    public:
+        /** Function called when Handler is invoked */
+        virtual void operator()(Cycle_t skipped) = 0;
+        virtual ~WakeHandlerBase() {}
+    };
+
+    /** Wake Handler class with user-data argument
+     * @tparam classT Type of the Object
+     * @tparam argT Type of the argument
+     */
+    template <typename classT, typename argT = void>
+    class WakeHandler : public WakeHandlerBase {
+    private:
+        typedef void (classT::*PtrMember)(Cycle_t, argT);
+        classT* object;
+        const PtrMember member;
+        argT data;
+
+    public:
+        /** Constructor
+         * @param object - Pointer to Object upon which to call the handler
+         * @param member - Member function to call as the handler
+         * @param data - Additional argument to pass to handler
+         */
+        WakeHandler( classT* const object, PtrMember member, argT data ) :
+            object(object),
+            member(member),
+            data(data)
+        {}
+
+        void operator()(Cycle_t skipped) override {
+            (object->*member)(skipped,data);
+        }
+    };
+
+    /** Wake Handler class without user-data
+     * @tparam classT Type of the Object
+     */
+    template <typename classT>
+    class WakeHandler<classT, void> : public WakeHandlerBase {
+    private:
+        typedef void (classT::*PtrMember)(Cycle_t);
+        classT* object;
+        const PtrMember member;
+
+    public:
+        /** Constructor
+         * @param object - Pointer to Object upon which to call the handler
+         * @param member - Member function to call as the handler
+         */
+        WakeHandler( classT* const object, PtrMember member ) :
+            object(object),
+            member(member)
+        {}
+
+        void operator()(Cycle_t skipped) override {
+            (object->*member)(skipped);
+        }
+    };
+
+
+    /** Base class for clock groups.  A group is a single handler on the
+     * clock that ticks every member of one component type with one
+     * call (see BaseComponent::registerClockGroup()).
+     */
+    class GroupBase : public HandlerBase {
+    public:
+        /** Number of components in the group */
+        virtual size_t size() const = 0;
+    };
+
+    /** Clock group for components of type classT.
+     *
+     * The tick function is called once per cycle with the members in
+     * the order they joined.  Members may keep their per-cycle state in
+     * arrays shared by the type, so that the tick function can work
+     * through it as structures of arrays.  The group takes the place of
+     * a handler in the clock's calling order: it is called where its
+     * first member registered, before handlers registered later.  An
+     * empty group leaves the clock and is added back (at the end) when
+     * a member joins.
+     * @tparam classT Type of the members
+     */
+    template <typename classT>
+    class Group : public GroupBase {
+    public:
+        /** Function called each cycle for all the members */
+        typedef void (*BatchTick)(Cycle_t cycle, classT* const* members, size_t count);
+
+        Group( BatchTick tick ) :
+            tick(tick),
+            numRemoved(0),
+            active(true),
+            ticking(false)
+        {}
+
+        BatchTick getTick() const { return tick; }
+
+        /** Add a member.  A component already in the group is not
+         * added again.
+         * @return True if the group had left the clock and must be
+         * registered again
+         */
+        bool add( classT* member ) {
+            if ( slots.insert(std::make_pair(member, members.size())).second ) {
+                members.push_back(member);
+            }
+            if ( active ) return false;
+            active = true;
+            return true;
+        }
+
+        /** Remove a member, keeping the others in order.  Members
+         * removed by the tick function are dropped once it returns.
+         * Leaves a NULL entry that is closed up before the next tick,
+         * or once gaps make up half the list, so removal is O(1)
+         * amortized. */
+        void remove( classT* member ) {
+            if ( ticking ) {
+                removed.push_back(member);
+                return;
+            }
+            typename std::unordered_map<classT*, size_t>::iterator it = slots.find(member);
+            if ( it == slots.end() ) return;
+            members[it->second] = NULL;
+            slots.erase(it);
+            numRemoved++;
+            if ( numRemoved * 2 > members.size() ) compact();
+        }
+
+        size_t size() const override { return slots.size(); }
+
+        bool operator()(Cycle_t cycle) override {
+            // The tick function is only ever shown the members
+            if ( numRemoved > 0 ) compact();
+            if ( members.empty() ) {
+                active = false;
+                return true;
+            }
+            ticking = true;
+            (*tick)(cycle, members.data(), members.size());
+            ticking = false;
+            if ( !removed.empty() ) {
+                for ( classT* member : removed ) remove(member);
+                removed.clear();
+            }
+            return false;
+        }
+
+    private:
+        /** Close up the gaps left by removed members, keeping their order */
+        void compact() {
+            size_t count = 0;
+            for ( size_t i = 0; i < members.size(); i++ ) {
+                classT* member = members[i];
+                if ( member == NULL ) continue;
+                if ( i != count ) {
+                    members[count] = member;
+                    slots[member] = count;
+                }
+                count++;
+            }
+            members.resize(count);
+            numRemoved = 0;
+        }
+
+        BatchTick tick;
+        std::vector<classT*> members;
+        /** Position of each member in members */
+        std::unordered_map<classT*, size_t> slots;
+        std::vector<classT*> removed;
+        /** Number of NULL entries in members */
+        size_t numRemoved;
+        /** False once the group has left the clock */
+        bool active;
+        bool ticking;
+    };
+
+    /** Return the group for components of type, or NULL if there is none */
+    GroupBase* getGroup( const std::type_info& type ) const;
+    /** Record the group for components of type.  The group must already
+     * be registered as a handler; the clock takes ownership. */
+    void addGroup( const std::type_info& type, GroupBase* group );
+
     /**
      * Activates this clock object, by inserting into the simulation's
      * timeVortex for future execution.
@@ -122,17 +318,36 @@ public:
 private:
 /*     typedef std::list<Clock::HandlerBase*> HandlerMap_t; */
     typedef std::vector<Clock::HandlerBase*> StaticHandlerMap_t;
+    /** Position of each registered handler in staticHandlerMap */
+    typedef std::unordered_multimap<Clock::HandlerBase*, size_t> HandlerIndex_t;
 
 
     Clock() { }
 
     void execute( void ) override;
 
+    /** Remove the handler at position index of staticHandlerMap */
+    void removeHandler( size_t index );
+    /** Close up the gaps left by removed handlers */
+    void compact();
+
     Cycle_t            currentCycle;
     TimeConverter*     period;
+    /** Handlers in calling order.  Removed handlers leave a NULL
+     * entry, which is dropped once gaps make up half the list, so
+     * removal is O(1) amortized. */
     StaticHandlerMap_t staticHandlerMap;
+    HandlerIndex_t     handlerIndex;
+    /** Clock groups, by component type.  Owned by the clock whether
+     * or not they are in staticHandlerMap. */
+    std::map<std::type_index, GroupBase*> groups;
+    /** Number of NULL entries in staticHandlerMap */
+    size_t             numRemoved;
     SimTime_t          next;
     bool               scheduled;
+    /** True while execute() is calling the handlers, when the list
+     * must not be compacted */
+    bool               executing;
     
 };
 
@@ -0,0 +1,119 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/clockGate.h>
+
+#include <sst/core/simulation.h>
+
+namespace SST {
+namespace Core {
+
+ClockGate::ClockGate() :
+    num_idle(0)
+{
+}
+
+ClockGate::~ClockGate()
+{
+    // Handlers still idle are off their clocks, so nothing else will
+    // delete them.  The others belong to a clock or to the component.
+    for ( Entry& entry : entries ) {
+        if ( entry.idle ) delete entry.handler;
+        delete entry.wake;
+    }
+}
+
+void
+ClockGate::idle(TimeConverter* tc, Clock::HandlerBase* handler, Clock::WakeHandlerBase* wake, Cycle_t last_cycle)
+{
+    Entry* entry = NULL;
+    for ( Entry& e : entries ) {
+        if ( e.handler == handler ) {
+            entry = &e;
+            break;
+        }
+    }
+    if ( entry == NULL ) {
+        Entry e = { tc, handler, NULL, 0, false };
+        entries.push_back(e);
+        entry = &entries.back();
+    }
+
+    if ( entry->wake != wake ) {
+        delete entry->wake;
+        entry->wake = wake;
+    }
+    if ( entry->idle ) return;
+
+    entry->tc = tc;
+    entry->last_cycle = last_cycle;
+    entry->idle = true;
+    num_idle++;
+    Simulation::getSimulation()->unregisterClock(tc, handler, CLOCKPRIORITY);
+}
+
+bool
+ClockGate::isIdle(Clock::HandlerBase* handler) const
+{
+    for ( const Entry& entry : entries ) {
+        if ( entry.handler == handler ) return entry.idle;
+    }
+    return false;
+}
+
+Cycle_t
+ClockGate::wake(Entry& entry)
+{
+    entry.idle = false;
+    num_idle--;
+
+    Cycle_t next = Simulation::getSimulation()->reregisterClock(entry.tc, entry.handler, CLOCKPRIORITY);
+    if ( entry.wake != NULL ) {
+        Cycle_t skipped = next > entry.last_cycle ? next - entry.last_cycle - 1 : 0;
+        (*entry.wake)(skipped);
+    }
+    return next;
+}
+
+Cycle_t
+ClockGate::wake(Clock::HandlerBase* handler)
+{
+    for ( Entry& entry : entries ) {
+        if ( entry.handler == handler && entry.idle ) return wake(entry);
+    }
+    return 0;
+}
+
+void
+ClockGate::cancel(Clock::HandlerBase* handler)
+{
+    for ( Entry& entry : entries ) {
+        if ( entry.handler == handler && entry.idle ) {
+            entry.idle = false;
+            num_idle--;
+            return;
+        }
+    }
+}
+
+void
+ClockGate::wakeAll()
+{
+    // Indexed, since a wake handler may idle a new handler and grow
+    // the list
+    for ( size_t i = 0; i < entries.size() && num_idle > 0; i++ ) {
+        if ( entries[i].idle ) wake(entries[i]);
+    }
+}
+
+}
+}
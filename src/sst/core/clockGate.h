@@ -0,0 +1,95 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_CLOCKGATE_H
+#define SST_CORE_CLOCKGATE_H
+
+#include <sst/core/sst_types.h>
+#include <sst/core/clock.h>
+
+#include <vector>
+
+namespace SST {
+
+class TimeConverter;
+
+namespace Core {
+
+/**
+ * Holds the clock handlers a component has put to sleep with
+ * BaseComponent::idleClock(), and puts them back on their clocks when
+ * an event arrives on one of the component's links.
+ *
+ * There is one gate per LinkMap, created the first time a component
+ * using that map idles a clock, and each of the map's links points to
+ * it.  Links without a gate (the usual case) pay only a NULL check per
+ * delivered event, and a gate with nothing idle only a counter check.
+ * A component and its links run on one thread, so the gate needs no
+ * locking.
+ */
+class ClockGate {
+
+public:
+    ClockGate();
+    ~ClockGate();
+
+    /**
+     * Take handler off the clock for tc until the next wake().  The
+     * handler last ran, or would have run, in cycle last_cycle.  The
+     * gate owns wake, which may be NULL; passing a different wake
+     * handler for the same clock handler replaces (and deletes) the
+     * old one.  The gate also owns handler while it is idle, and
+     * deletes it if it is still idle when the gate is destroyed.
+     */
+    void idle(TimeConverter* tc, Clock::HandlerBase* handler, Clock::WakeHandlerBase* wake, Cycle_t last_cycle);
+
+    /** Returns true if handler is idled on this gate */
+    bool isIdle(Clock::HandlerBase* handler) const;
+
+    /**
+     * Put handler back on its clock now.  Its wake handler is called
+     * with the number of cycles it missed.
+     * \return The next cycle in which the handler will be called
+     */
+    Cycle_t wake(Clock::HandlerBase* handler);
+
+    /** Forget an idle handler without putting it back on its clock */
+    void cancel(Clock::HandlerBase* handler);
+
+    /** Put every idle handler back on its clock.  Called as an event is delivered. */
+    inline void wake() {
+        if ( num_idle > 0 ) wakeAll();
+    }
+
+private:
+    struct Entry {
+        TimeConverter* tc;
+        Clock::HandlerBase* handler;
+        Clock::WakeHandlerBase* wake;
+        Cycle_t last_cycle;
+        bool idle;
+    };
+
+    ClockGate(const ClockGate&) = delete;
+    ClockGate& operator=(const ClockGate&) = delete;
+
+    void wakeAll();
+    Cycle_t wake(Entry& entry);
+
+    /** A component has only a few clock handlers, so a vector is searched */
+    std::vector<Entry> entries;
+    uint32_t num_idle;
+};
+
+}
+}
+
+#endif // SST_CORE_CLOCKGATE_H
@@ -0,0 +1,353 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/componentProfile.h>
+
+#include <sst/core/componentInfo.h>
+#include <sst/core/configGraph.h>
+#include <sst/core/link.h>
+#include <sst/core/output.h>
+#include <sst/core/simulation.h>
+#include <sst/core/warnmacros.h>
+#include <sst/core/interprocess/shmcomm.h>
+
+#ifdef SST_CONFIG_HAVE_MPI
+DISABLE_WARN_MISSING_OVERRIDE
+#include <mpi.h>
+REENABLE_WARNING
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+namespace SST {
+namespace Core {
+
+ComponentProfile* ComponentProfile::instance = NULL;
+thread_local uint32_t ComponentProfile::current_thread = 0;
+
+// Components that barely showed up in the profile still get some
+// weight, so the partitioner does not pile them all onto one part
+static const float MIN_COMPONENT_WEIGHT = 0.01;
+// Link weights are kept within this range of the average, which
+// bounds the gains the partitioners have to track
+static const float MIN_LINK_WEIGHT = 1.0 / 16;
+static const float MAX_LINK_WEIGHT = 64;
+
+typedef std::chrono::steady_clock ProfileClock;
+
+static inline double secondsSince(ProfileClock::time_point start)
+{
+    return std::chrono::duration<double>(ProfileClock::now() - start).count();
+}
+
+
+class ComponentProfile::EventHandler : public Event::HandlerBase {
+public:
+    EventHandler(Event::HandlerBase* handler, ComponentRecord* component, LinkRecord* link) :
+        handler(handler), component(component), link(link)
+    {}
+
+    ~EventHandler() { delete handler; }
+
+    void operator()(Event* event) override {
+        ProfileClock::time_point start = ProfileClock::now();
+        (*handler)(event);
+        component->event_time += secondsSince(start);
+        component->events++;
+        if ( link != NULL ) link->events++;
+    }
+
+private:
+    Event::HandlerBase* handler;
+    ComponentRecord* component;
+    LinkRecord* link;
+};
+
+
+class ComponentProfile::ClockHandler : public Clock::HandlerBase {
+public:
+    ClockHandler(Clock::HandlerBase* handler, ComponentRecord* component) :
+        handler(handler), component(component)
+    {}
+
+    ~ClockHandler() { delete handler; }
+
+    bool operator()(Cycle_t cycle) override {
+        ProfileClock::time_point start = ProfileClock::now();
+        bool done = (*handler)(cycle);
+        component->clock_time += secondsSince(start);
+        component->ticks++;
+        return done;
+    }
+
+private:
+    Clock::HandlerBase* handler;
+    ComponentRecord* component;
+};
+
+
+ComponentProfile::ComponentProfile(const std::string& file, const RankInfo& rank, const RankInfo& world_size) :
+    file(file), rank(rank), world_size(world_size), threads(world_size.thread)
+{
+}
+
+void
+ComponentProfile::init(const std::string& file, const RankInfo& rank, const RankInfo& world_size)
+{
+    if ( instance != NULL ) return;
+    instance = new ComponentProfile(file, rank, world_size);
+}
+
+void
+ComponentProfile::setRank(uint32_t new_rank)
+{
+    rank.rank = new_rank;
+}
+
+void
+ComponentProfile::addLink(LinkId_t id, const std::string& name)
+{
+    LinkRecord& record = thread().links[id];
+    record.name = name;
+    record.events = 0;
+}
+
+ComponentProfile::ComponentRecord*
+ComponentProfile::getComponent(ComponentId_t id)
+{
+    // Subcomponents are charged to the component that holds them
+    id = COMPONENT_ID_MASK(id);
+    auto it = thread().components.find(id);
+    if ( it != thread().components.end() ) return &it->second;
+
+    ComponentRecord& record = thread().components[id];
+    record.name = Simulation::getSimulation()->getComponentInfo(id)->getName();
+    record.events = 0;
+    record.event_time = 0;
+    record.ticks = 0;
+    record.clock_time = 0;
+    return &record;
+}
+
+Event::HandlerBase*
+ComponentProfile::wrapEventHandler(ComponentId_t id, Link* link, Event::HandlerBase* handler)
+{
+    if ( handler == NULL ) return NULL;
+
+    // Self links have no name and are left out of the link counts
+    LinkRecord* link_record = NULL;
+    auto it = thread().links.find(link->id);
+    if ( it != thread().links.end() ) link_record = &it->second;
+
+    return new EventHandler(handler, getComponent(id), link_record);
+}
+
+Clock::HandlerBase*
+ComponentProfile::wrapClockHandler(ComponentId_t id, Clock::HandlerBase* handler)
+{
+    Clock::HandlerBase*& wrapper = thread().clocks[handler];
+    if ( wrapper == NULL ) wrapper = new ClockHandler(handler, getComponent(id));
+    return wrapper;
+}
+
+
+static void rankBarrier()
+{
+    if ( Interprocess::ShmComm::active() ) {
+        Interprocess::ShmComm::get()->barrier();
+    }
+#ifdef SST_CONFIG_HAVE_MPI
+    else {
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+#endif
+}
+
+void
+ComponentProfile::writeTotals(const std::string& path, const Totals& totals)
+{
+    FILE* fp = fopen(path.c_str(), "w");
+    if ( fp == NULL ) {
+        Output::getDefaultObject().fatal(CALL_INFO, 1, "Unable to open component profile %s for writing: %s\n", path.c_str(), strerror(errno));
+    }
+    fprintf(fp, "# SST component profile (fields are tab separated)\n");
+    fprintf(fp, "# component <name> <events> <event handler seconds> <clock ticks> <clock handler seconds>\n");
+    fprintf(fp, "# link <name> <events received>\n");
+    for ( auto& comp : totals.components ) {
+        const ComponentRecord& r = comp.second;
+        fprintf(fp, "component\t%s\t%" PRIu64 "\t%.9g\t%" PRIu64 "\t%.9g\n",
+                comp.first.c_str(), r.events, r.event_time, r.ticks, r.clock_time);
+    }
+    for ( auto& link : totals.links ) {
+        fprintf(fp, "link\t%s\t%" PRIu64 "\n", link.first.c_str(), link.second);
+    }
+    fclose(fp);
+}
+
+void
+ComponentProfile::readTotals(const std::string& path, Totals& totals)
+{
+    Output& out = Output::getDefaultObject();
+    std::ifstream is(path.c_str());
+    if ( !is ) {
+        out.fatal(CALL_INFO, 1, "Unable to read component profile %s: %s\n", path.c_str(), strerror(errno));
+    }
+
+    std::string line;
+    int line_num = 0;
+    while ( std::getline(is, line) ) {
+        line_num++;
+        if ( line.empty() || line[0] == '#' ) continue;
+
+        std::vector<std::string> fields;
+        std::istringstream ls(line);
+        std::string field;
+        while ( std::getline(ls, field, '\t') ) fields.push_back(field);
+
+        if ( fields[0] == "component" && fields.size() == 6 ) {
+            ComponentRecord& r = totals.components[fields[1]];
+            r.events += strtoull(fields[2].c_str(), NULL, 10);
+            r.event_time += strtod(fields[3].c_str(), NULL);
+            r.ticks += strtoull(fields[4].c_str(), NULL, 10);
+            r.clock_time += strtod(fields[5].c_str(), NULL);
+        }
+        else if ( fields[0] == "link" && fields.size() == 3 ) {
+            totals.links[fields[1]] += strtoull(fields[2].c_str(), NULL, 10);
+        }
+        else {
+            out.fatal(CALL_INFO, 1, "Malformed line %d in component profile %s\n", line_num, path.c_str());
+        }
+    }
+}
+
+void
+ComponentProfile::write()
+{
+    // Combine this rank's threads.  Both ends of a link on this rank
+    // share one record, but the ends of a link between threads each
+    // count what they received, so links are summed by name.
+    Totals totals;
+    for ( ThreadRecord& thr : threads ) {
+        for ( auto& comp : thr.components ) {
+            ComponentRecord& r = totals.components[comp.second.name];
+            r.events += comp.second.events;
+            r.event_time += comp.second.event_time;
+            r.ticks += comp.second.ticks;
+            r.clock_time += comp.second.clock_time;
+        }
+        for ( auto& link : thr.links ) {
+            totals.links[link.second.name] += link.second.events;
+        }
+    }
+
+    if ( world_size.rank == 1 ) {
+        writeTotals(file, totals);
+    }
+    else {
+        // Each rank writes its part next to the profile, then rank 0
+        // adds them up
+        std::string part = file + ".rank" + std::to_string(rank.rank);
+        writeTotals(part, totals);
+        rankBarrier();
+        if ( rank.rank != 0 ) return;
+
+        Totals all;
+        for ( uint32_t r = 0; r < world_size.rank; r++ ) {
+            std::string name = file + ".rank" + std::to_string(r);
+            readTotals(name, all);
+            unlink(name.c_str());
+        }
+        writeTotals(file, all);
+    }
+
+    Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "# Wrote component profile to %s\n", file.c_str());
+}
+
+
+double
+ComponentProfile::apply(const std::string& file, ConfigGraph* graph)
+{
+    Totals totals;
+    readTotals(file, totals);
+
+    Output& out = Output::getDefaultObject();
+    ConfigComponentMap_t& comps = graph->getComponentMap();
+    ConfigLinkMap_t& links = graph->getLinkMap();
+
+    // Components cost the time spent in their handlers
+    double total_time = 0;
+    size_t found_comps = 0;
+    std::vector<double> cost(comps.size(), -1);
+    size_t i = 0;
+    for ( ConfigComponent& comp : comps ) {
+        auto it = totals.components.find(comp.name);
+        if ( it != totals.components.end() ) {
+            cost[i] = it->second.event_time + it->second.clock_time;
+            total_time += cost[i];
+            found_comps++;
+        }
+        i++;
+    }
+    if ( total_time > 0 ) {
+        double avg = total_time / found_comps;
+        i = 0;
+        for ( ConfigComponent& comp : comps ) {
+            comp.weight = cost[i] < 0 ? 1.0 : std::max(MIN_COMPONENT_WEIGHT, (float)(cost[i] / avg));
+            i++;
+        }
+    }
+
+    // Cutting a link costs the events that cross it
+    double events_per_weight = 0;
+    uint64_t total_events = 0;
+    size_t found_links = 0;
+    for ( ConfigLink& link : links ) {
+        auto it = totals.links.find(link.name);
+        if ( it == totals.links.end() ) continue;
+        total_events += it->second;
+        found_links++;
+    }
+    if ( total_events > 0 ) {
+        double avg = (double)total_events / found_links;
+        events_per_weight = avg;
+        for ( ConfigLink& link : links ) {
+            auto it = totals.links.find(link.name);
+            if ( it == totals.links.end() ) {
+                link.weight = 1.0;
+                continue;
+            }
+            float weight = it->second / avg;
+            link.weight = std::min(MAX_LINK_WEIGHT, std::max(MIN_LINK_WEIGHT, weight));
+        }
+    }
+
+    if ( found_comps == 0 && found_links == 0 ) {
+        out.output("WARNING: No component or link in component profile %s matches the current model, so the partition weights are unchanged\n",
+                   file.c_str());
+        return 0;
+    }
+    out.verbose(CALL_INFO, 1, 0, "# Set partition weights from component profile %s: %zu of %zu components and %zu of %zu links found\n",
+                file.c_str(), found_comps, comps.size(), found_links, links.size());
+    return events_per_weight;
+}
+
+}
+}
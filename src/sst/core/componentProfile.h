@@ -0,0 +1,147 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_COMPONENTPROFILE_H
+#define SST_CORE_COMPONENTPROFILE_H
+
+#include <sst/core/sst_types.h>
+#include <sst/core/rankInfo.h>
+#include <sst/core/clock.h>
+#include <sst/core/event.h>
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SST {
+
+class ConfigGraph;
+class Link;
+
+namespace Core {
+
+/**
+ * Records the time each component spends in its event handlers and
+ * clock handlers, and the number of events received on each link, so
+ * that a later run of the same model can be partitioned by observed
+ * cost rather than by guessed weights.  Enabled with
+ * --output-component-profile; when it is off, get() returns NULL and
+ * handlers are installed unchanged.
+ *
+ * Time is charged to the top level component, which is the unit the
+ * partitioners place, so the cost of subcomponents lands on their
+ * parent.  Each thread records into its own slot, chosen by
+ * setThread(); a component only ever runs on its own thread, so no
+ * locking is needed.
+ *
+ * The file is read back with --load-component-profile, which sets the
+ * component and link weights in the ConfigGraph before partitioning.
+ * Components and links are matched by name.
+ */
+class ComponentProfile {
+
+public:
+    /** Turn on profiling.  Called by main() once the command line is parsed. */
+    static void init(const std::string& file, const RankInfo& rank, const RankInfo& world_size);
+
+    /** Returns the profiler, or NULL if profiling is off */
+    static ComponentProfile* get() { return instance; }
+
+    /** Set the thread that this OS thread records into */
+    static void setThread(uint32_t thread) { current_thread = thread; }
+
+    /** Called in a rank forked from rank 0 */
+    void setRank(uint32_t rank);
+
+    /** Name the link with this ID so its traffic can be reported.  Called during wireup. */
+    void addLink(LinkId_t id, const std::string& name);
+
+    /**
+     * Returns a handler that times handler and charges it to the
+     * component with this ID.  The returned handler owns handler.
+     */
+    Event::HandlerBase* wrapEventHandler(ComponentId_t id, Link* link, Event::HandlerBase* handler);
+
+    /**
+     * Returns a handler that times handler and charges it to the
+     * component with this ID.  Asking again for the same handler
+     * returns the same wrapper, so the wrapper can be found again to
+     * reregister or unregister the clock.  The wrapper owns handler.
+     */
+    Clock::HandlerBase* wrapClockHandler(ComponentId_t id, Clock::HandlerBase* handler);
+
+    /**
+     * Write the profile.  Every rank must call this; rank 0 combines the
+     * results into the profile file.
+     */
+    void write();
+
+    /**
+     * Set the weights in graph from a profile written by an earlier
+     * run.  Component weights become their measured time and link
+     * weights their traffic, each scaled so the average is 1.
+     * Components and links missing from the profile keep the average
+     * weight.
+     * \return The events per unit of link weight, or 0 if the profile
+     * has no link traffic
+     */
+    static double apply(const std::string& file, ConfigGraph* graph);
+
+private:
+    struct ComponentRecord {
+        std::string name;
+        uint64_t events;
+        double event_time;
+        uint64_t ticks;
+        double clock_time;
+    };
+
+    struct LinkRecord {
+        std::string name;
+        uint64_t events;
+    };
+
+    struct ThreadRecord {
+        std::map<ComponentId_t, ComponentRecord> components;
+        std::unordered_map<LinkId_t, LinkRecord> links;
+        std::map<Clock::HandlerBase*, Clock::HandlerBase*> clocks;
+    };
+
+    class EventHandler;
+    class ClockHandler;
+
+    /** Totals for a profile, keyed by name */
+    struct Totals {
+        std::map<std::string, ComponentRecord> components;
+        std::map<std::string, uint64_t> links;
+    };
+
+    ComponentProfile(const std::string& file, const RankInfo& rank, const RankInfo& world_size);
+
+    ThreadRecord& thread() { return threads[current_thread]; }
+    ComponentRecord* getComponent(ComponentId_t id);
+    static void writeTotals(const std::string& path, const Totals& totals);
+    static void readTotals(const std::string& path, Totals& totals);
+
+    static ComponentProfile* instance;
+    static thread_local uint32_t current_thread;
+
+    std::string file;
+    RankInfo rank;
+    RankInfo world_size;
+    std::vector<ThreadRecord> threads;
+};
+
+}
+}
+
+#endif // SST_CORE_COMPONENTPROFILE_H
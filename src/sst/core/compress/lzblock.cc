@@ -0,0 +1,211 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/compress/lzblock.h>
+
+#include <cstring>
+#include <stdint.h>
+
+namespace SST {
+namespace Core {
+namespace Compress {
+
+// Format constants from the LZ4 block specification
+static const size_t MIN_MATCH = 4;
+static const size_t LAST_LITERALS = 5;   // Block always ends with literals
+static const size_t MF_LIMIT = 12;       // No match may start after end - 12
+static const size_t MAX_OFFSET = 65535;
+static const int    HASH_LOG = 12;
+
+static inline uint32_t read32(const uint8_t* p)
+{
+    uint32_t v;
+    ::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t hash32(uint32_t v)
+{
+    return (v * 2654435761U) >> (32 - HASH_LOG);
+}
+
+// Writes the continuation bytes for a length field that overflowed
+// its 4 bits in the token
+static inline uint8_t* writeLength(uint8_t* op, size_t len)
+{
+    while ( len >= 255 ) {
+        *op++ = 255;
+        len -= 255;
+    }
+    *op++ = (uint8_t)len;
+    return op;
+}
+
+// Emits one sequence.  With match_len == 0 only the literals are
+// written, which is how the final sequence of a block is encoded.
+// Returns NULL if the sequence would not fit.
+static uint8_t* writeSequence(uint8_t* op, const uint8_t* oend,
+                              const uint8_t* literals, size_t lit_len,
+                              size_t offset, size_t match_len)
+{
+    size_t needed = 1 + lit_len + (lit_len / 255) + 1;
+    if ( match_len ) needed += 2 + ((match_len - MIN_MATCH) / 255) + 1;
+    if ( (size_t)(oend - op) < needed ) return NULL;
+
+    uint8_t* token = op++;
+    if ( lit_len >= 15 ) {
+        *token = 15 << 4;
+        op = writeLength(op, lit_len - 15);
+    }
+    else {
+        *token = (uint8_t)(lit_len << 4);
+    }
+    ::memcpy(op, literals, lit_len);
+    op += lit_len;
+
+    if ( match_len ) {
+        *op++ = (uint8_t)(offset & 0xff);
+        *op++ = (uint8_t)(offset >> 8);
+        size_t ml = match_len - MIN_MATCH;
+        if ( ml >= 15 ) {
+            *token |= 15;
+            op = writeLength(op, ml - 15);
+        }
+        else {
+            *token |= (uint8_t)ml;
+        }
+    }
+    return op;
+}
+
+size_t lzCompressBound(size_t size)
+{
+    return size + (size / 255) + 16;
+}
+
+size_t lzCompress(const char* src, size_t size, char* dst, size_t capacity)
+{
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(src);
+    const uint8_t* ip = base;
+    const uint8_t* anchor = base;
+    const uint8_t* iend = base + size;
+    uint8_t* op = reinterpret_cast<uint8_t*>(dst);
+    const uint8_t* oend = op + capacity;
+
+    if ( size > MF_LIMIT ) {
+        const uint8_t* mflimit = iend - MF_LIMIT;
+        const uint8_t* matchlimit = iend - LAST_LITERALS;
+
+        // Positions are stored relative to base, so a zeroed table
+        // just yields candidates that fail the byte comparison
+        uint32_t table[1 << HASH_LOG];
+        ::memset(table, 0, sizeof(table));
+
+        ip++;
+        while ( ip <= mflimit ) {
+            uint32_t seq = read32(ip);
+            uint32_t h = hash32(seq);
+            const uint8_t* ref = base + table[h];
+            table[h] = (uint32_t)(ip - base);
+
+            if ( ref >= ip || (size_t)(ip - ref) > MAX_OFFSET || read32(ref) != seq ) {
+                // Skip faster through data that is not matching
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+
+            // Extend the match backwards into pending literals
+            while ( ip > anchor && ref > base && ip[-1] == ref[-1] ) {
+                ip--;
+                ref--;
+            }
+
+            size_t len = MIN_MATCH;
+            while ( ip + len < matchlimit && ip[len] == ref[len] ) len++;
+
+            op = writeSequence(op, oend, anchor, ip - anchor, ip - ref, len);
+            if ( NULL == op ) return 0;
+
+            ip += len;
+            anchor = ip;
+            if ( ip <= mflimit ) {
+                table[hash32(read32(ip - 2))] = (uint32_t)(ip - 2 - base);
+            }
+        }
+    }
+
+    op = writeSequence(op, oend, anchor, iend - anchor, 0, 0);
+    if ( NULL == op ) return 0;
+    return op - reinterpret_cast<uint8_t*>(dst);
+}
+
+size_t lzDecompress(const char* src, size_t size, char* dst, size_t capacity)
+{
+    const uint8_t* ip = reinterpret_cast<const uint8_t*>(src);
+    const uint8_t* iend = ip + size;
+    uint8_t* const ostart = reinterpret_cast<uint8_t*>(dst);
+    uint8_t* op = ostart;
+    const uint8_t* oend = ostart + capacity;
+
+    while ( ip < iend ) {
+        uint8_t token = *ip++;
+
+        size_t lit_len = token >> 4;
+        if ( lit_len == 15 ) {
+            uint8_t b;
+            do {
+                if ( ip >= iend ) return 0;
+                b = *ip++;
+                lit_len += b;
+            } while ( b == 255 );
+        }
+        if ( lit_len > (size_t)(iend - ip) || lit_len > (size_t)(oend - op) ) return 0;
+        ::memcpy(op, ip, lit_len);
+        op += lit_len;
+        ip += lit_len;
+
+        // The last sequence has no match part
+        if ( ip == iend ) break;
+
+        if ( iend - ip < 2 ) return 0;
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if ( offset == 0 || offset > (size_t)(op - ostart) ) return 0;
+
+        size_t match_len = token & 15;
+        if ( match_len == 15 ) {
+            uint8_t b;
+            do {
+                if ( ip >= iend ) return 0;
+                b = *ip++;
+                match_len += b;
+            } while ( b == 255 );
+        }
+        match_len += MIN_MATCH;
+        if ( match_len > (size_t)(oend - op) ) return 0;
+
+        const uint8_t* match = op - offset;
+        if ( offset >= match_len ) {
+            ::memcpy(op, match, match_len);
+            op += match_len;
+        }
+        else {
+            // Overlapping copy repeats the last offset bytes
+            for ( size_t i = 0; i < match_len; i++ ) *op++ = *match++;
+        }
+    }
+    return op - ostart;
+}
+
+} // namespace Compress
+} // namespace Core
+} // namespace SST
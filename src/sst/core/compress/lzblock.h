@@ -0,0 +1,49 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_COMPRESS_LZBLOCK_H
+#define SST_CORE_COMPRESS_LZBLOCK_H
+
+#include <cstddef>
+
+namespace SST {
+namespace Core {
+namespace Compress {
+
+/**
+ * Fast byte-oriented LZ77 codec that writes the LZ4 block format.
+ * It trades ratio for speed and is intended for buffers that are
+ * compressed and decompressed once, such as the serialized event
+ * streams exchanged between ranks.
+ */
+
+/** Returns the worst case compressed size of an input of size bytes */
+size_t lzCompressBound(size_t size);
+
+/**
+ * Compress size bytes from src into dst.
+ * @return Number of bytes written to dst, or 0 if the result did not
+ *         fit in capacity bytes.
+ */
+size_t lzCompress(const char* src, size_t size, char* dst, size_t capacity);
+
+/**
+ * Decompress size bytes from src into dst.
+ * @return Number of bytes written to dst, or 0 if the input is
+ *         malformed or would overrun capacity bytes.
+ */
+size_t lzDecompress(const char* src, size_t size, char* dst, size_t capacity);
+
+} // namespace Compress
+} // namespace Core
+} // namespace SST
+
+#endif // SST_CORE_COMPRESS_LZBLOCK_H
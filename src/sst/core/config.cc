@@ -56,10 +56,12 @@ Config::Config(RankInfo rankInfo)
     timeBase    = "1 ps";
     heartbeatPeriod = "N";
     partitioner = "sst.linear";
+    thread_partitioner = "";
     generator   = "NONE";
     generator_options   = "";
     timeVortex  = "sst.timevortex.priority_queue";
     dump_component_graph_file = "";
+    partition_report_file = "";
 
     char* wd_buf = (char*) malloc( sizeof(char) * PATH_MAX );
     getcwd(wd_buf, PATH_MAX);
@@ -78,6 +80,9 @@ Config::Config(RankInfo rankInfo)
     enable_sig_handling = true;
     output_core_prefix = "@x SST Core: ";
     print_timing = false;
+    sync_compress_threshold = 0;
+    shm_ranks = 0;
+    partition_threads_on_ranks = false;
 
 #ifdef __SST_DEBUG_EVENT_TRACKING__
     event_dump_file = "";
@@ -120,6 +125,7 @@ static const struct sstLongOpts_s sstOptions[] = {
     DEF_FLAGOPT("disable-signal-handlers",  0,      "disable SST automatic dynamic library environment configuration", &Config::disableSigHandlers),
     DEF_FLAGOPT("no-env-config",            0,      "disable SST environment configuration", &Config::disableEnvConfig),
     DEF_FLAGOPT("print-timing-info",        0,      "print SST timing information", &Config::enablePrintTiming),
+    DEF_FLAGOPT("partition-threads-on-ranks", 0,    "with --thread-partitioner, split each rank across its threads on that rank after the graph is distributed, instead of on rank 0", &Config::enablePartitionThreadsOnRanks),
     /* HiddenNoConfigDesc */
     DEF_ARGOPT("sdl-file",          "FILE",         "SST Configuration file", &Config::setConfigFile),
     DEF_ARGOPT("stopAtCycle",       "TIME",         "set time at which simulation will end execution", &Config::setStopAt),
@@ -133,6 +139,7 @@ static const struct sstLongOpts_s sstOptions[] = {
     DEF_ARGOPT("heartbeat-period",  "PERIOD",       "set time for heartbeats to be published (these are approximate timings, published by the core, to update on progress), default is every 10000 simulated seconds", &Config::setHeartbeat),
     DEF_ARGOPT("timebase",          "TIMEBASE",     "sets the base time step of the simulation (default: 1ps)", &Config::setTimebase),
     DEF_ARGOPT("partitioner",       "PARTITIONER",  "select the partitioner to be used. <lib.partitionerName>", &Config::setPartitioner),
+    DEF_ARGOPT("thread-partitioner","PARTITIONER",  "partition hierarchically: --partitioner splits the graph across ranks, then this partitioner splits each rank across its threads. <lib.partitionerName>", &Config::setThreadPartitioner),
     DEF_ARGOPT("generator",         "GENERATOR",    "select the generator to be used to build simulation <lib.generatorName>", &Config::setGenerator),
     DEF_ARGOPT("gen-options",       "OPTSTIRNG",    "options to be passed to generator function", &Config::setGeneratorOptions),
     DEF_ARGOPT("timeVortex ",       "MODULE",       "select TimeVortex implementation <lib.timevortex>", &Config::setTimeVortex),
@@ -141,13 +148,22 @@ static const struct sstLongOpts_s sstOptions[] = {
     DEF_ARGOPT("output-dot",        "FILE",         "file to write SST configuration graph (in GraphViz format)", &Config::setWriteDot),
     DEF_ARGOPT("output-xml",        "FILE",         "file to write SST configuration graph (in XML format)", &Config::setWriteXML),
     DEF_ARGOPT("output-json",       "FILE",         "file to write SST configuration graph (in JSON format)", &Config::setWriteJSON),
+    DEF_ARGOPT("output-graph-binary","FILE",        "file to write the partitioned SST configuration graph to (in binary format, see --load-graph-binary)", &Config::setWriteGraphBinary),
+    DEF_ARGOPT("load-graph-binary", "FILE",         "load a configuration graph written by --output-graph-binary instead of running the sdl-file and partitioner", &Config::setLoadGraphBinary),
+    DEF_ARGOPT("distribute-graph-file","FILE",      "distribute the partitioned graph to MPI ranks by writing it to FILE, which all ranks must be able to read, instead of sending it from rank 0", &Config::setGraphDistributionFile),
+    DEF_ARGOPT("profile-startup",   "FILE",         "write the wall time and memory used by each startup phase, per rank and thread, to FILE (in JSON format)", &Config::setStartupProfileFile),
+    DEF_ARGOPT("output-component-profile","FILE",   "write the time each component spends in its event and clock handlers, and the events received on each link, to FILE (see --load-component-profile)", &Config::setWriteComponentProfile),
+    DEF_ARGOPT("load-component-profile","FILE",     "set the component and link weights used by the partitioner from a profile written by --output-component-profile", &Config::setLoadComponentProfile),
     DEF_ARGOPT("output-partition",  "FILE",         "file to write SST component partitioning information", &Config::setWritePartition),
+    DEF_ARGOPT("output-partition-report","FILE",    "print a summary of the partition's quality (links cut between ranks and threads, balance, min_part) and write the full report, including each pair of ranks, to FILE (in JSON format)", &Config::setWritePartitionReport),
     DEF_ARGOPT("output-prefix-core","STR",          "set the SST::Output prefix for the core", &Config::setOutputPrefix),
 #ifdef USE_MEMPOOL
     DEF_ARGOPT("output-undeleted-events",   "FILE", "file to write information about all undeleted events at the end of simulation (STDOUT and STDERR can be used to output to console)", &Config::setWriteUndeleted),
 #endif
     DEF_ARGOPT("model-options",     "STR",          "provide options to the python configuration script", &Config::setModelOptions),
     DEF_ARGOPT_SHORT("num_threads", 'n',   "NUM",   "number of parallel threads to use per rank", &Config::setNumThreads),
+    DEF_ARGOPT("compress-sync",     "BYTES",        "compress cross-rank synchronization buffers of at least BYTES bytes (default 0, disabled)", &Config::setSyncCompress),
+    DEF_ARGOPT("shm-ranks",         "NUM",          "run NUM ranks as processes on this node that communicate through shared memory instead of MPI (MPI is not started in this mode)", &Config::setShmRanks),
     {{NULL, 0, 0, 0}, NULL, NULL, NULL, NULL}
 };
 static const size_t nLongOpts = (sizeof(sstOptions) / sizeof(sstLongOpts_s)) -1;
@@ -156,7 +172,9 @@ static const size_t nLongOpts = (sizeof(sstOptions) / sizeof(sstLongOpts_s)) -1;
 bool Config::usage() {
 #ifdef SST_CONFIG_HAVE_MPI
 	int this_rank = 0;
-	MPI_Comm_rank(MPI_COMM_WORLD, &this_rank);
+	int mpi_initialized = 0;
+	MPI_Initialized(&mpi_initialized);
+	if ( mpi_initialized ) MPI_Comm_rank(MPI_COMM_WORLD, &this_rank);
 	if(this_rank != 0)  return true;
 #endif
 
@@ -286,7 +304,7 @@ Config::parseCmdLine(int argc, char* argv[]) {
     /* Sanity check, and other duties */
     Output::setFileName( debugFile != "/dev/null" ? debugFile : "sst_output" );
 
-    if ( configFile == "NONE" && generator == "NONE" ) {
+    if ( configFile == "NONE" && generator == "NONE" && load_graph_binary == "" ) {
         cout << "ERROR: no sdl-file and no generator specified" << endl;
         cout << "  Usage: " << run_name << " sdl-file [options]" << endl;
         return -1;
@@ -316,6 +334,26 @@ Config::parseCmdLine(int argc, char* argv[]) {
 	output_json.insert( 0, output_directory );
     }
 
+    if( output_graph_binary.size() > 0 && isFileNameOnly(output_graph_binary) ) {
+	output_graph_binary.insert( 0, output_directory );
+    }
+
+    if( graph_distribution_file.size() > 0 && isFileNameOnly(graph_distribution_file) ) {
+	graph_distribution_file.insert( 0, output_directory );
+    }
+
+    if( startup_profile_file.size() > 0 && isFileNameOnly(startup_profile_file) ) {
+	startup_profile_file.insert( 0, output_directory );
+    }
+
+    if( output_component_profile.size() > 0 && isFileNameOnly(output_component_profile) ) {
+	output_component_profile.insert( 0, output_directory );
+    }
+
+    if( partition_report_file.size() > 0 && isFileNameOnly(partition_report_file) ) {
+	partition_report_file.insert( 0, output_directory );
+    }
+
     if( debugFile.size() > 0 && isFileNameOnly(debugFile) ) {
 	debugFile.insert( 0, output_directory );
     }
@@ -449,6 +487,13 @@ bool Config::setPartitioner(const std::string &arg) {
     }
     return true;
 }
+bool Config::setThreadPartitioner(const std::string &arg) {
+    thread_partitioner = arg;
+    if ( thread_partitioner.find('.') == thread_partitioner.npos ) {
+        thread_partitioner = "sst." + thread_partitioner;
+    }
+    return true;
+}
 /* TODO: Error checking */
 bool Config::setGenerator(const std::string &arg) { generator = arg; return true; }
 
@@ -470,7 +515,14 @@ bool Config::setWriteConfig(const std::string &arg) { output_config_graph = arg;
 bool Config::setWriteDot(const std::string &arg) { output_dot = arg; return true; }
 bool Config::setWriteXML(const std::string &arg){ output_xml = arg; return true; }
 bool Config::setWriteJSON(const std::string &arg) { output_json = arg; return true; }
+bool Config::setWriteGraphBinary(const std::string &arg) { output_graph_binary = arg; return true; }
+bool Config::setLoadGraphBinary(const std::string &arg) { load_graph_binary = arg; return true; }
+bool Config::setGraphDistributionFile(const std::string &arg) { graph_distribution_file = arg; return true; }
+bool Config::setStartupProfileFile(const std::string &arg) { startup_profile_file = arg; return true; }
+bool Config::setWriteComponentProfile(const std::string &arg) { output_component_profile = arg; return true; }
+bool Config::setLoadComponentProfile(const std::string &arg) { load_component_profile = arg; return true; }
 bool Config::setWritePartition(const std::string &arg) { dump_component_graph_file = arg; return true; }
+bool Config::setWritePartitionReport(const std::string &arg) { partition_report_file = arg; return true; }
 bool Config::setOutputPrefix(const std::string &arg) { output_core_prefix = arg; return true; }
 #ifdef USE_MEMPOOL
 bool Config::setWriteUndeleted(const std::string &arg) { event_dump_file = arg; return true; }
@@ -509,6 +561,29 @@ bool Config::setNumThreads(const std::string &arg) {
 }
 
 
+bool Config::setSyncCompress(const std::string &arg) {
+    errno = E_OK;
+    unsigned long long bytes = strtoull(arg.c_str(), NULL, 0);
+    if ( errno == E_OK ) {
+        sync_compress_threshold = bytes;
+        return true;
+    }
+    fprintf(stderr, "Failed to parse [%s] as a compression threshold\n", arg.c_str());
+    return false;
+}
+
+
+bool Config::setShmRanks(const std::string &arg) {
+    errno = E_OK;
+    unsigned long nranks = strtoul(arg.c_str(), NULL, 0);
+    if ( errno == E_OK ) {
+        shm_ranks = nranks;
+        return true;
+    }
+    fprintf(stderr, "Failed to parse [%s] as number of ranks\n", arg.c_str());
+    return false;
+}
+
 
 /* Getters */
 
@@ -64,6 +64,7 @@ public:
     std::string     heartbeatPeriod;    /*!< Sets the heartbeat period for the simulation */
     std::string     timeBase;           /*!< Timebase of simulation */
     std::string     partitioner;        /*!< Partitioner to use */
+    std::string     thread_partitioner; /*!< Partitioner to split each rank across its threads (empty = partition ranks and threads together) */
     std::string     generator;          /*!< Generator to use */
     std::string     generator_options;  /*!< Options to pass to the generator */
     std::string     timeVortex;         /*!< TimeVortex implementation to use */
@@ -71,9 +72,16 @@ public:
     std::string     output_dot;         /*!< File to dump dot output */
     std::string     output_xml;         /*!< File to dump XML output */
     std::string     output_json;        /*!< File to dump JSON output */
+    std::string     output_graph_binary; /*!< File to dump the partitioned graph to in binary format */
+    std::string     load_graph_binary;  /*!< Binary graph file to load instead of building the graph */
+    std::string     graph_distribution_file; /*!< File used to distribute the graph to MPI ranks (empty = send from rank 0) */
+    std::string     startup_profile_file; /*!< File to write the startup phase profile to (JSON) */
+    std::string     output_component_profile; /*!< File to write the time spent in each component to */
+    std::string     load_component_profile; /*!< Component profile from an earlier run to set partitioning weights from */
     std::string     output_directory;   /*!< Output directory to dump all files to */
     std::string     model_options;      /*!< Options to pass to Python Model generator */
     std::string     dump_component_graph_file; /*!< File to dump component graph */
+    std::string     partition_report_file; /*!< File to write the partition quality report to (JSON) */
     std::string     output_core_prefix;  /*!< Set the SST::Output prefix for the core */
 
     RankInfo        world_size;         /*!< Number of ranks, threads which should be invoked per rank */
@@ -81,6 +89,9 @@ public:
     bool	        no_env_config;      /*!< Bypass compile-time environmental configuration */
     bool            enable_sig_handling; /*!< Enable signal handling */
     bool            print_timing;       /*!< Print SST timing information */
+    uint64_t        sync_compress_threshold; /*!< Compress cross-rank sync buffers at least this large (0 = off) */
+    uint32_t        shm_ranks;          /*!< Number of ranks to run as processes on this node using shared memory (0 = use MPI) */
+    bool            partition_threads_on_ranks; /*!< Run the thread level of a hierarchical partition on each rank after graph distribution */
 
 #ifdef USE_MEMPOOL
     std::string     event_dump_file;    /*!< File to dump undeleted events to */
@@ -97,6 +108,7 @@ public:
     bool disableSigHandlers()   { enable_sig_handling = false; return true;}
     bool disableEnvConfig()     { no_env_config = true; return true;}
     bool enablePrintTiming()    { print_timing = true; return true;}
+    bool enablePartitionThreadsOnRanks() { partition_threads_on_ranks = true; return true;}
 
     bool setConfigFile(const std::string &arg);
     bool setDebugFile(const std::string &arg);
@@ -108,6 +120,7 @@ public:
     bool setHeartbeat(const std::string &arg);
     bool setTimebase(const std::string &arg);
     bool setPartitioner(const std::string &arg);
+    bool setThreadPartitioner(const std::string &arg);
     bool setGenerator(const std::string &arg);
     bool setGeneratorOptions(const std::string &arg);
     bool setTimeVortex(const std::string &arg);
@@ -116,13 +129,22 @@ public:
     bool setWriteDot(const std::string &arg);
     bool setWriteXML(const std::string &arg);
     bool setWriteJSON(const std::string &arg);
+    bool setWriteGraphBinary(const std::string &arg);
+    bool setLoadGraphBinary(const std::string &arg);
+    bool setGraphDistributionFile(const std::string &arg);
+    bool setStartupProfileFile(const std::string &arg);
+    bool setWriteComponentProfile(const std::string &arg);
+    bool setLoadComponentProfile(const std::string &arg);
     bool setWritePartition(const std::string &arg);
+    bool setWritePartitionReport(const std::string &arg);
     bool setOutputPrefix(const std::string &arg);
 #ifdef USE_MEMPOOL
     bool setWriteUndeleted(const std::string &arg);
 #endif
     bool setModelOptions(const std::string &arg);
     bool setNumThreads(const std::string &arg);
+    bool setSyncCompress(const std::string &arg);
+    bool setShmRanks(const std::string &arg);
 
 
     Simulation::Mode_t getRunMode() { return runMode; }
@@ -137,6 +159,7 @@ public:
         std::cout << "stopAfterSec = " << stopAfterSec << std::endl;
         std::cout << "timeBase = " << timeBase << std::endl;
         std::cout << "partitioner = " << partitioner << std::endl;
+        std::cout << "thread_partitioner = " << thread_partitioner << std::endl;
         std::cout << "generator = " << generator << std::endl;
         std::cout << "gen_options = " << generator_options << std::endl;
         std::cout << "output_config_graph = " << output_config_graph << std::endl;
@@ -144,11 +167,21 @@ public:
         std::cout << "no_env_config = " << no_env_config << std::endl;
         std::cout << "output_directory = " << output_directory << std::endl;
         std::cout << "output_json = " << output_json << std::endl;
+        std::cout << "output_graph_binary = " << output_graph_binary << std::endl;
+        std::cout << "load_graph_binary = " << load_graph_binary << std::endl;
+        std::cout << "graph_distribution_file = " << graph_distribution_file << std::endl;
+        std::cout << "startup_profile_file = " << startup_profile_file << std::endl;
+        std::cout << "output_component_profile = " << output_component_profile << std::endl;
+        std::cout << "load_component_profile = " << load_component_profile << std::endl;
+        std::cout << "partition_report_file = " << partition_report_file << std::endl;
         std::cout << "model_options = " << model_options << std::endl;
         std::cout << "num_threads = " << world_size.thread << std::endl;
         std::cout << "enable_sig_handling = " << enable_sig_handling << std::endl;
         std::cout << "output_core_prefix = " << output_core_prefix << std::endl;
         std::cout << "print_timing=" << print_timing << std::endl;
+        std::cout << "sync_compress_threshold = " << sync_compress_threshold << std::endl;
+        std::cout << "shm_ranks = " << shm_ranks << std::endl;
+        std::cout << "partition_threads_on_ranks = " << partition_threads_on_ranks << std::endl;
     }
 
 
@@ -174,18 +207,29 @@ public:
         ser & stopAfterSec;
         ser & timeBase;
         ser & partitioner;
+        ser & thread_partitioner;
         ser & generator;
         ser & generator_options;
         ser & dump_component_graph_file;
+        ser & partition_report_file;
         ser & output_config_graph;
         ser & output_xml;
         ser & output_json;
+        ser & output_graph_binary;
+        ser & load_graph_binary;
+        ser & graph_distribution_file;
+        ser & startup_profile_file;
+        ser & output_component_profile;
+        ser & load_component_profile;
         ser & no_env_config;
         ser & model_options;
         ser & world_size;
         ser & enable_sig_handling;
         ser & output_core_prefix;
         ser & print_timing;
+        ser & sync_compress_threshold;
+        ser & shm_ranks;
+        ser & partition_threads_on_ranks;
     }
 
 private:
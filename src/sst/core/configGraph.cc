@@ -15,6 +15,7 @@
 
 #include <fstream>
 #include <algorithm>
+#include <thread>
 
 #include <sst/core/component.h>
 #include <sst/core/config.h>
@@ -364,113 +365,235 @@ ConfigGraph::checkRanks(RankInfo ranks)
     return true;
 }
 
+/**
+ * Split [0, count) into contiguous chunks, at most one per thread, and
+ * call body(chunk, begin, end) on each.  The first chunk runs on the
+ * calling thread.  Chunks are numbered in order, so results kept per
+ * chunk can be combined deterministically.
+ */
+template <typename Body>
+static void parallelChunks(size_t count, int num_threads, Body body)
+{
+    // Not worth starting a thread for less than this many items
+    const size_t min_chunk = 4096;
+    size_t num_chunks = std::min<size_t>(std::max(num_threads, 1), count / min_chunk);
+    if ( num_chunks == 0 ) num_chunks = 1;
+
+    std::vector<std::thread> threads;
+    for ( size_t i = 1; i < num_chunks; i++ ) {
+        threads.emplace_back(body, i, count * i / num_chunks, count * (i + 1) / num_chunks);
+    }
+    body(0, 0, count / num_chunks);
+    for ( auto& t : threads ) {
+        t.join();
+    }
+}
+
+/**
+ * The distinct values seen by one chunk, in the order they were first
+ * seen, along with where each was first seen
+ */
+template <typename T>
+struct FirstSeen {
+    std::set<T> seen;
+    std::vector<std::pair<T, size_t> > order;
+
+    void add(const T& value, size_t where)
+    {
+        if ( seen.insert(value).second ) order.push_back(std::make_pair(value, where));
+    }
+
+    /** Combine the per chunk lists (in chunk order) into one */
+    static std::vector<std::pair<T, size_t> > merge(std::vector<FirstSeen>& chunks)
+    {
+        std::set<T> seen;
+        std::vector<std::pair<T, size_t> > order;
+        for ( auto& chunk : chunks ) {
+            for ( auto& item : chunk.order ) {
+                if ( seen.insert(item.first).second ) order.push_back(item);
+            }
+            std::set<T>().swap(chunk.seen);
+        }
+        return order;
+    }
+};
+
 void
-ConfigGraph::postCreationCleanup()
+ConfigGraph::postCreationCleanup(int num_threads)
 {
+    comps.finalizeBulkLoad();
+    links.finalizeBulkLoad();
+
+    // Links use only a few distinct latency strings.  Collect them in
+    // parallel and convert each one once, in the order they first
+    // appear so that a bad string fails on the same link as it would in
+    // a serial pass.  TimeLord serializes its callers anyway.
+    std::vector<ConfigLink>& link_data = links.data;
+    std::vector<FirstSeen<std::string> > latencies(std::max(num_threads, 1));
+    parallelChunks(link_data.size(), num_threads, [&](size_t chunk, size_t begin, size_t end) {
+            for ( size_t i = begin; i < end; i++ ) {
+                latencies[chunk].add(link_data[i].latency_str[0], i);
+                latencies[chunk].add(link_data[i].latency_str[1], i);
+            }
+        });
+
     TimeLord *timeLord = Simulation::getTimeLord();
-    for ( ConfigLink &link : getLinkMap() ) {
-        link.updateLatencies(timeLord);
+    std::map<std::string, SimTime_t> cycles;
+    for ( auto& lat : FirstSeen<std::string>::merge(latencies) ) {
+        cycles[lat.first] = timeLord->getSimCycles(lat.first, __FUNCTION__);
     }
 
+    parallelChunks(link_data.size(), num_threads, [&](size_t, size_t begin, size_t end) {
+            for ( size_t i = begin; i < end; i++ ) {
+                ConfigLink& link = link_data[i];
+                link.latency[0] = cycles.find(link.latency_str[0])->second;
+                link.latency[1] = cycles.find(link.latency_str[1])->second;
+            }
+        });
+
+    size_t sets = shareParams();
+    Output::getDefaultObject().verbose(CALL_INFO, 2, 0, "# %zu components share %zu distinct parameter sets\n",
+                                       comps.size(), sets);
+}
+
+
+static void shareComponentParams(ConfigComponent& comp, Params::SharedSetTable& table)
+{
+    table.intern(comp.params);
+    for ( auto& sub : comp.subComponents ) {
+        shareComponentParams(sub, table);
+    }
+}
+
+void
+ConfigGraph::shareParams(Params::SharedSetTable& table)
+{
+    for ( ConfigComponent& comp : comps ) {
+        shareComponentParams(comp, table);
+    }
+}
+
+size_t
+ConfigGraph::shareParams()
+{
+    Params::SharedSetTable table;
+    shareParams(table);
+    return table.size();
 }
 
 
 bool
-ConfigGraph::checkForStructuralErrors()
+ConfigGraph::checkForStructuralErrors(int num_threads)
 {
     // Output object for error messages
     Output &output = Output::getDefaultObject();
-    
+
+    std::vector<ConfigLink>& link_data = links.data;
+    std::vector<ConfigComponent>& comp_data = comps.data;
+    size_t chunks = std::max(num_threads, 1);
+
     // Check to make sure there are no dangling links.  A dangling
     // link is found by looking though the links in the graph and
     // making sure there are components on both sides of the link.
+    // Each thread keeps its own messages so they can be printed in
+    // link order.
+    std::vector<std::vector<std::string> > dangling(chunks);
+    parallelChunks(link_data.size(), num_threads, [&](size_t chunk, size_t begin, size_t end) {
+            char buf[1024];
+            for ( size_t i = begin; i < end; i++ ) {
+                const ConfigLink& clink = link_data[i];
+                // This one should never happen since the slots are
+                // initialized in order, but just in case...
+                if ( clink.component[0] == ULONG_MAX ) {
+                    snprintf(buf, sizeof(buf), "WARNING:  Found dangling link: %s.  It is connected on one side to component %s.\n",
+                             clink.name.c_str(), comps[clink.component[1]].name.c_str());
+                    dangling[chunk].push_back(buf);
+                }
+                if ( clink.component[1] == ULONG_MAX ) {
+                    snprintf(buf, sizeof(buf), "WARNING:  Found dangling link: %s.  It is connected on one side to component %s.\n",
+                             clink.name.c_str(), comps[clink.component[0]].name.c_str());
+                    dangling[chunk].push_back(buf);
+                }
+            }
+        });
     bool found_error = false;
-    for( ConfigLinkMap_t::iterator iter = links.begin();
-         iter != links.end(); ++iter )
-    {
-        ConfigLink& clink = *iter;
-        // This one should never happen since the slots are
-        // initialized in order, but just in case...
-        if ( clink.component[0] == ULONG_MAX ) {
-            output.output("WARNING:  Found dangling link: %s.  It is connected on one side to component %s.\n",clink.name.c_str(),
-                   comps[clink.component[1]].name.c_str());
-            found_error = true;
-        }
-        if ( clink.component[1] == ULONG_MAX ) {
-            output.output("WARNING:  Found dangling link: %s.  It is connected on one side to component %s.\n",clink.name.c_str(),
-                   comps[clink.component[0]].name.c_str());
+    for ( auto& messages : dangling ) {
+        for ( auto& msg : messages ) {
+            output.output("%s", msg.c_str());
             found_error = true;
         }
     }
 
-    // Check to make sure all the component names are unique.  This
-    // could be memory intensive for large graphs because we will
-    // simply put things in a set and check to see if there are
-    // duplicates.
-    std::set<std::string> name_set;
-    int count = 10;
-    for ( ConfigComponentMap_t::iterator iter = comps.begin();
-          iter != comps.end(); ++iter )
-    {
-        ConfigComponent* ccomp = &(*iter);
-        if ( name_set.find(ccomp->name) == name_set.end() ) {
-            name_set.insert(ccomp->name);
-        }
-        else {
-            found_error = true;
-            output.output("WARNING:  Found duplicate component name: %s\n",ccomp->name.c_str());
-            count--;
-            if ( count == 0 ) {
-                output.output("Maximum name clashes reached, no more checks will be made.\n");
-                break;
+    // Check to make sure all the component names are unique.  Each
+    // thread sorts a chunk of (name, index) pairs, then the chunks are
+    // merged.  Within a run of equal names, everything after the first
+    // component is a duplicate.  Duplicates are reported in component
+    // order, as they would be by a single pass.
+    typedef std::pair<const std::string*, size_t> NameEntry_t;
+    auto name_less = [](const NameEntry_t& a, const NameEntry_t& b) {
+        int cmp = a.first->compare(*b.first);
+        return cmp < 0 || (cmp == 0 && a.second < b.second);
+    };
+    std::vector<NameEntry_t> names(comp_data.size());
+    std::vector<size_t> chunk_end(chunks, 0);
+    parallelChunks(comp_data.size(), num_threads, [&](size_t chunk, size_t begin, size_t end) {
+            for ( size_t i = begin; i < end; i++ ) {
+                names[i] = NameEntry_t(&comp_data[i].name, i);
             }
-        }
+            std::sort(names.begin() + begin, names.begin() + end, name_less);
+            chunk_end[chunk] = end;
+        });
+    size_t merged = chunk_end[0];
+    for ( size_t i = 1; i < chunks && chunk_end[i] != 0; i++ ) {
+        std::inplace_merge(names.begin(), names.begin() + merged, names.begin() + chunk_end[i], name_less);
+        merged = chunk_end[i];
     }
 
-#if 1
-    // Check to see if all the port names are valid
-    count = 10;
-    for ( ConfigComponentMap_t::iterator iter = comps.begin();
-          iter != comps.end(); ++iter )
-    {
-        ConfigComponent* ccomp = &(*iter);
-
-//        bool found = false;
-        for ( unsigned int i = 0; i < ccomp->links.size(); i++ ) {
-            for ( int j = 0; j < 2; j++ ) {
-                const ConfigLink& link = links[ccomp->links[i]];
-                if ( link.component[j] == ccomp->id ) {
-                    // If port is not found, print a warning
-                    if (!Factory::getFactory()->isPortNameValid(ccomp->type, link.port[j]) ) {
-                        // For now this is not a fatal error
-                        // found_error = true;
-                        output.fatal(CALL_INFO, 1, "ERROR:  Attempting to connect to unknown port: %s, "
-                                      "in component %s of type %s.\n",
-                                      link.port[j].c_str(), ccomp->name.c_str(), ccomp->type.c_str());
-                        count--;
+    std::vector<size_t> duplicates;
+    for ( size_t i = 1; i < names.size(); i++ ) {
+        if ( *names[i].first == *names[i-1].first ) duplicates.push_back(names[i].second);
+    }
+    std::sort(duplicates.begin(), duplicates.end());
+    int count = 10;
+    for ( size_t index : duplicates ) {
+        found_error = true;
+        output.output("WARNING:  Found duplicate component name: %s\n",comp_data[index].name.c_str());
+        count--;
+        if ( count == 0 ) {
+            output.output("Maximum name clashes reached, no more checks will be made.\n");
+            break;
+        }
+    }
+    std::vector<NameEntry_t>().swap(names);
+
+    // Check to see if all the port names are valid.  The checks
+    // themselves go through the Factory, which may load libraries, so
+    // the threads only collect the distinct (type, port) pairs.  They
+    // are checked in the order they first appear, so the error names
+    // the same component a single pass would.
+    typedef std::pair<std::string, std::string> TypePort_t;
+    std::vector<FirstSeen<TypePort_t> > ports(chunks);
+    parallelChunks(comp_data.size(), num_threads, [&](size_t chunk, size_t begin, size_t end) {
+            for ( size_t i = begin; i < end; i++ ) {
+                const ConfigComponent& ccomp = comp_data[i];
+                for ( unsigned int l = 0; l < ccomp.links.size(); l++ ) {
+                    const ConfigLink& link = links[ccomp.links[l]];
+                    for ( int j = 0; j < 2; j++ ) {
+                        if ( link.component[j] == ccomp.id ) {
+                            ports[chunk].add(TypePort_t(ccomp.type, link.port[j]), i);
+                        }
                     }
                 }
             }
+        });
+    for ( auto& port : FirstSeen<TypePort_t>::merge(ports) ) {
+        if ( !Factory::getFactory()->isPortNameValid(port.first.first, port.first.second) ) {
+            const ConfigComponent& ccomp = comp_data[port.second];
+            output.fatal(CALL_INFO, 1, "ERROR:  Attempting to connect to unknown port: %s, "
+                         "in component %s of type %s.\n",
+                         port.first.second.c_str(), ccomp.name.c_str(), ccomp.type.c_str());
         }
-        if ( count <= 0 ) {
-            output.output("Maximum bad port names reached, no more checks will be made.\n");
-            break;
-        }
-
-        // if ( name_set.find(ccomp->name) == name_set.end() ) {
-        //     name_set.insert(ccomp->name);
-        // }
-        // else {
-        //     found_error = true;
-        //     output.output("Found duplicate component name: %s\n",ccomp->name.c_str());
-        //     count--;
-        //     if ( count == 0 ) {
-        //         output.output("Maximum name clashes reached, no more checks will be made.\n");
-        //         break;
-        //     }
-        // }
     }
-#endif
 
     return found_error;
 }
@@ -628,6 +751,31 @@ ConfigGraph::addLink(ComponentId_t comp_id, string link_name, string port, strin
 	findComponent(comp_id)->links.push_back(link.id);
 }
 
+LinkId_t
+ConfigGraph::addLink(const string &link_name, ComponentId_t comp0, const string &port0, const string &latency0,
+                     ComponentId_t comp1, const string &port1, const string &latency1, bool no_cut)
+{
+    LinkId_t id = links.size();
+    if ( !link_names.insert(std::make_pair(link_name, id)).second ) {
+        Output::getDefaultObject().fatal(CALL_INFO, 1, "ERROR: Link name already used: %s\n", link_name.c_str());
+    }
+
+    ConfigLink link(id, link_name);
+    link.current_ref = 2;
+    link.component[0] = comp0;
+    link.component[1] = comp1;
+    link.port[0] = port0;
+    link.port[1] = port1;
+    link.latency_str[0] = latency0;
+    link.latency_str[1] = latency1;
+    link.no_cut = no_cut;
+    links.push_back(link);
+
+    findComponent(comp0)->links.push_back(id);
+    findComponent(comp1)->links.push_back(id);
+    return id;
+}
+
 void
 ConfigGraph::setLinkNoCut(string link_name)
 {
@@ -720,6 +868,75 @@ ConfigGraph::getSubGraph(const std::set<uint32_t>& rank_set)
         }
     }
 
+    copyStatisticConfig(graph);
+
+    return graph;
+}
+
+void
+ConfigGraph::indexRanks(uint32_t num_ranks, RankIndex& index)
+{
+    index.comps.assign(num_ranks, std::vector<ComponentId_t>());
+    index.links.assign(num_ranks, std::vector<LinkId_t>());
+
+    for ( ConfigComponentMap_t::iterator it = comps.begin(); it != comps.end(); ++it ) {
+        index.comps[it->rank.rank].push_back(it->id);
+    }
+
+    // A link that crosses ranks belongs to both of them, and each side
+    // also needs a (parameterless) copy of the component on the other end
+    for ( ConfigLinkMap_t::iterator it = links.begin(); it != links.end(); ++it ) {
+        const ConfigLink& link = *it;
+        uint32_t rank0 = findComponent(link.component[0])->rank.rank;
+        uint32_t rank1 = findComponent(link.component[1])->rank.rank;
+
+        index.links[rank0].push_back(link.id);
+        if ( rank0 != rank1 ) {
+            index.links[rank1].push_back(link.id);
+            index.comps[rank0].push_back(COMPONENT_ID_MASK(link.component[1]));
+            index.comps[rank1].push_back(COMPONENT_ID_MASK(link.component[0]));
+        }
+    }
+}
+
+ConfigGraph*
+ConfigGraph::getRankSubGraph(uint32_t rank, RankIndex& index)
+{
+    ConfigGraph* graph = new ConfigGraph();
+
+    // Components and links have to go in in ID order (see getSubGraph())
+    std::vector<ComponentId_t>& comp_ids = index.comps[rank];
+    std::sort(comp_ids.begin(), comp_ids.end());
+    comp_ids.erase(std::unique(comp_ids.begin(), comp_ids.end()), comp_ids.end());
+
+    for ( ComponentId_t id : comp_ids ) {
+        const ConfigComponent& comp = comps[id];
+        if ( comp.rank.rank == rank ) {
+            graph->comps.push_back(comp.cloneWithoutLinks());
+        }
+        else {
+            graph->comps.push_back(comp.cloneWithoutLinksOrParams());
+        }
+    }
+
+    for ( LinkId_t id : index.links[rank] ) {
+        const ConfigLink& link = links[id];
+        graph->links.insert(ConfigLink(link));
+        graph->findComponent(link.component[0])->links.push_back(link.id);
+        graph->findComponent(link.component[1])->links.push_back(link.id);
+    }
+
+    std::vector<ComponentId_t>().swap(comp_ids);
+    std::vector<LinkId_t>().swap(index.links[rank]);
+
+    copyStatisticConfig(graph);
+
+    return graph;
+}
+
+void
+ConfigGraph::copyStatisticConfig(ConfigGraph* graph) const
+{
     // Copy the statistic configuration to the sub-graph
     graph->statOutputs = this->statOutputs;
     /* Only need to copy StatGroups which are referenced in this subgraph */
@@ -732,8 +949,6 @@ ConfigGraph::getSubGraph(const std::set<uint32_t>& rank_set)
         }
     }
     graph->setStatisticLoadLevel(this->getStatLoadLevel());
-
-    return graph;
 }
 
 PartitionGraph*
@@ -770,10 +985,30 @@ ConfigGraph::getPartitionGraph()
 
 PartitionGraph*
 ConfigGraph::getCollapsedPartitionGraph()
+{
+    return collapsePartitionGraph(RankInfo::UNASSIGNED, NULL);
+}
+
+PartitionGraph*
+ConfigGraph::getCollapsedPartitionGraph(uint32_t rank, const RankIndex& index)
+{
+    return collapsePartitionGraph(rank, &index);
+}
+
+PartitionGraph*
+ConfigGraph::collapsePartitionGraph(uint32_t rank, const RankIndex* index)
 {
     PartitionGraph* graph = new PartitionGraph();
 
+    // With a rank given, leave out the components on other ranks and
+    // the links to them.  No-cut groups never span ranks.
+    bool all_ranks = rank == RankInfo::UNASSIGNED;
+    auto onRank = [&](ComponentId_t id) {
+        return all_ranks || comps[COMPONENT_ID_MASK(id)].rank.rank == rank;
+    };
+
     SparseVectorMap<LinkId_t> deleted_links;
+    deleted_links.beginBulkLoad();
     
     PartitionComponentMap_t& pcomps = graph->getComponentMap();
     PartitionLinkMap_t& plinks = graph->getLinkMap();
@@ -782,12 +1017,10 @@ ConfigGraph::getCollapsedPartitionGraph()
     // insert both components and links in order of ID, which is the
     // key for the SparseVectorMap in both cases
     ComponentIdMap_t group;
-    for ( ConfigComponentMap_t::iterator it = comps.begin(); it != comps.end(); ++it ) {
-        const ConfigComponent& comp = *it;
-
+    auto addComponent = [&](const ConfigComponent& comp) {
         // Get the no-cut group for this component
         group.clear();
-        getConnectedNoCutComps(it->id,group);
+        getConnectedNoCutComps(comp.id,group);
 
 
         // Check to see if this has already been put in map.  Do this
@@ -811,6 +1044,9 @@ ConfigGraph::getCollapsedPartitionGraph()
                 for ( LinkId_t id : comp.allLinks() ) {
                     const ConfigLink& link = links[id];
 
+                    // Links to other ranks are left out of the graph below
+                    if ( !onRank(link.component[0]) || !onRank(link.component[1]) ) continue;
+
                     if ( !group.contains(COMPONENT_ID_MASK(link.component[0])) || !group.contains(COMPONENT_ID_MASK(link.component[1]) ) ) {
                         pcomp.links.push_back(link.id);
                     }
@@ -820,11 +1056,36 @@ ConfigGraph::getCollapsedPartitionGraph()
                 }
             }
         }
+    };
+
+    // The index lists the rank's own components in ID order, followed
+    // by copies of the components its links reach on other ranks
+    if ( index == NULL ) {
+        for ( ConfigComponentMap_t::iterator it = comps.begin(); it != comps.end(); ++it ) {
+            addComponent(*it);
+        }
+    }
+    else {
+        for ( ComponentId_t id : index->comps[rank] ) {
+            const ConfigComponent& comp = comps[id];
+            if ( comp.rank.rank == rank ) addComponent(comp);
+        }
     }
 
     // Now add all but the deleted links to the partition graph
-    for ( ConfigLinkMap_t::iterator i = links.begin(); i != links.end(); ++i ) {
-        if ( !deleted_links.contains(i->id) ) plinks.push_back(*i);
+    deleted_links.finalizeBulkLoad();
+    auto addLink = [&](const ConfigLink& link) {
+        if ( !deleted_links.contains(link.id) && onRank(link.component[0]) && onRank(link.component[1]) ) plinks.push_back(link);
+    };
+    if ( index == NULL ) {
+        for ( ConfigLinkMap_t::iterator i = links.begin(); i != links.end(); ++i ) {
+            addLink(*i);
+        }
+    }
+    else {
+        for ( LinkId_t id : index->links[rank] ) {
+            addLink(links[id]);
+        }
     }
 
     // Just need to fix up the component fields for the links.  Do
@@ -58,6 +58,7 @@ public:
     std::string      latency_str[2];/*!< Temp string holding latency */
     int              current_ref;   /*!< Number of components currently referring to this Link */
     bool             no_cut;        /*!< If set to true, partitioner will not make a cut through this Link */
+    float            weight;        /*!< Partitioning weight for this link (the cost of cutting it) */
 
     // inline const std::string& key() const { return name; }
     inline LinkId_t key() const { return id; }
@@ -92,6 +93,8 @@ public:
         ser & latency[0];
         ser & latency[1];
         ser & current_ref;
+        ser & no_cut;
+        ser & weight;
     }
 
     ImplementSerializable(SST::ConfigLink)
@@ -100,7 +103,8 @@ private:
     friend class ConfigGraph;
     ConfigLink(LinkId_t id) :
         id(id),
-        no_cut(false)
+        no_cut(false),
+        weight(1.0)
     {
         current_ref = 0;
 
@@ -111,7 +115,8 @@ private:
 
     ConfigLink(LinkId_t id, const std::string &n) :
         id(id),
-        no_cut(false)
+        no_cut(false),
+        weight(1.0)
     {
         current_ref = 0;
         name = n;
@@ -353,14 +358,40 @@ public:
     /** Add a Link to a Component on a given Port */
     void addLink(ComponentId_t comp_id, std::string link_name, std::string port, std::string latency_str, bool no_cut = false);
 
+    /**
+     * Create a Link and connect both ends in one call.  The new Link
+     * always gets the next ID, so it is appended to the link map.
+     * Used by the bulk model building APIs.  A link name that is
+     * already in use is a fatal error.
+     */
+    LinkId_t addLink(const std::string &link_name, ComponentId_t comp0, const std::string &port0, const std::string &latency0,
+                     ComponentId_t comp1, const std::string &port1, const std::string &latency1, bool no_cut = false);
+
     /** Set a Link to be no-cut */
     void setLinkNoCut(std::string link_name);
 
-    /** Perform any post-creation cleanup processes */
-    void postCreationCleanup();
+    /**
+     * Put the component and link maps in bulk load mode while a model
+     * builds the graph, so that components and links can be added in
+     * any order without re-sorting the maps on every insert.  The maps
+     * are sorted once by postCreationCleanup().
+     */
+    void beginBulkLoad() {
+        comps.beginBulkLoad();
+        links.beginBulkLoad();
+    }
+
+    /** Perform any post-creation cleanup processes, using up to num_threads threads */
+    void postCreationCleanup(int num_threads = 1);
+
+    /**
+     * Make components (and subcomponents) with identical parameters
+     * share one copy of them.  Returns the number of distinct sets.
+     */
+    size_t shareParams();
 
-    /** Check the graph for Structural errors */
-    bool checkForStructuralErrors();
+    /** Check the graph for Structural errors, using up to num_threads threads */
+    bool checkForStructuralErrors(int num_threads = 1);
 
     // Temporary until we have a better API
     /** Return the map of components */
@@ -390,24 +421,66 @@ public:
     ConfigGraph* getSubGraph(uint32_t start_rank, uint32_t end_rank);
     ConfigGraph* getSubGraph(const std::set<uint32_t>& rank_set);
 
+    /** Components and links needed by each rank's subgraph */
+    struct RankIndex {
+        std::vector<std::vector<ComponentId_t> > comps;
+        std::vector<std::vector<LinkId_t> > links;
+    };
+    /**
+     * Find the contents of every rank's subgraph in a single pass over
+     * the graph.  Used to split the graph for all ranks at once rather
+     * than calling getSubGraph() for each of them.
+     */
+    void indexRanks(uint32_t num_ranks, RankIndex& index);
+    /**
+     * Build the subgraph for one rank from an index made by
+     * indexRanks().  Returns the same graph as getSubGraph() for a set
+     * holding only rank; the rank's entries in the index are released.
+     */
+    ConfigGraph* getRankSubGraph(uint32_t rank, RankIndex& index);
+
     PartitionGraph* getPartitionGraph();
     PartitionGraph* getCollapsedPartitionGraph();
+    /**
+     * Like getCollapsedPartitionGraph(), but only holds the components
+     * already assigned to rank and the links between them, found
+     * through an index made by indexRanks().  Used to split each rank
+     * across its threads without rescanning the whole graph per rank.
+     */
+    PartitionGraph* getCollapsedPartitionGraph(uint32_t rank, const RankIndex& index);
     void annotateRanks(PartitionGraph* graph);
     void getConnectedNoCutComps(ComponentId_t start, ComponentIdMap_t& group);
 
     void serialize_order(SST::Core::Serialization::serializer &ser) override
 	{
+        // Each distinct parameter set is written once, ahead of the
+        // components that refer to it
+        Params::SharedSetTable params_table;
+        if ( ser.mode() != SST::Core::Serialization::serializer::UNPACK ) {
+            shareParams(params_table);
+        }
+        params_table.serialize_order(ser);
+        Params::SharedSetTable* prev_table = Params::setSerializeTable(&params_table);
+
 		ser & links;
 		ser & comps;
 		ser & statOutputs;
 		ser & statLoadLevel;
         ser & statGroups;
+
+        Params::setSerializeTable(prev_table);
 	}
 
 private:
     friend class Simulation;
     friend class SSTSDLModelDefinition;
 
+    void copyStatisticConfig(ConfigGraph* graph) const;
+    void shareParams(Params::SharedSetTable& table);
+    /** Shared body of the getCollapsedPartitionGraph() calls; a NULL
+     * index collapses the whole graph */
+    PartitionGraph* collapsePartitionGraph(uint32_t rank, const RankIndex* index);
+
     ConfigLinkMap_t      links;
     ConfigComponentMap_t comps;
     std::map<std::string, ConfigStatGroup> statGroups;
@@ -457,6 +530,7 @@ public:
     ComponentId_t             component[2];
     SimTime_t                 latency[2];
     bool                      no_cut;
+    float                     weight;
 
     PartitionLink(const ConfigLink& cl) {
         id = cl.id;
@@ -465,6 +539,7 @@ public:
         latency[0] = cl.latency[0];
         latency[1] = cl.latency[1];
         no_cut = cl.no_cut;
+        weight = cl.weight;
     }
 
     inline LinkId_t key() const { return id; }
@@ -0,0 +1,252 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/configGraphBinary.h>
+
+#include <sst/core/configGraph.h>
+#include <sst/core/output.h>
+#include <sst/core/params.h>
+#include <sst/core/serialization/serializer.h>
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SST {
+namespace Core {
+
+static const char graph_magic[8] = { 'S', 'S', 'T', 'G', 'R', 'A', 'P', 'H' };
+
+uint64_t
+ConfigGraphBinary::writeSection(FILE* fp, const std::string& path, std::vector<char>& buffer, Section& section)
+{
+    off_t pos = ftello(fp);
+    uint64_t pad = (SECTION_ALIGN - (pos % SECTION_ALIGN)) % SECTION_ALIGN;
+    static const char zeros[SECTION_ALIGN] = { 0 };
+    if ( fwrite(zeros, 1, pad, fp) != pad ||
+         fwrite(buffer.data(), 1, buffer.size(), fp) != buffer.size() ) {
+        Output::getDefaultObject().fatal(CALL_INFO, 1, "Failed to write binary graph file %s: %s\n",
+                                         path.c_str(), strerror(errno));
+    }
+    section.offset = pos + pad;
+    section.size = buffer.size();
+    return section.size;
+}
+
+void
+ConfigGraphBinary::writeGraph(FILE* fp, const std::string& path, ConfigGraph* graph, Section& section)
+{
+    SST::Core::Serialization::serializer ser;
+    ser.start_sizing();
+    ser & *graph;
+
+    std::vector<char> buffer(ser.size());
+    ser.start_packing(buffer.data(), buffer.size());
+    ser & *graph;
+
+    writeSection(fp, path, buffer, section);
+}
+
+void
+ConfigGraphBinary::write(const std::string& path, ConfigGraph* graph, const RankInfo& world_size,
+                         SimTime_t min_part, const std::string& timebase, const std::string& thread_partitioner)
+{
+    Output& out = Output::getDefaultObject();
+
+    FILE* fp = fopen(path.c_str(), "wb");
+    if ( fp == NULL ) {
+        out.fatal(CALL_INFO, 1, "Unable to open binary graph file %s for writing: %s\n", path.c_str(), strerror(errno));
+    }
+
+    FileHeader hdr;
+    ::memset(&hdr, 0, sizeof(hdr));
+    ::memcpy(hdr.magic, graph_magic, sizeof(hdr.magic));
+    hdr.version = VERSION;
+    hdr.byte_order = BYTE_ORDER_MARK;
+    hdr.num_ranks = world_size.rank;
+    hdr.num_threads = world_size.thread;
+    hdr.min_part = min_part;
+
+    // The header and section table are rewritten once the offsets are known
+    std::vector<Section> table(world_size.rank);
+    if ( fwrite(&hdr, sizeof(hdr), 1, fp) != 1 ||
+         fwrite(table.data(), sizeof(Section), table.size(), fp) != table.size() ) {
+        out.fatal(CALL_INFO, 1, "Failed to write binary graph file %s: %s\n", path.c_str(), strerror(errno));
+    }
+
+    // Global section: everything every rank needs before it can
+    // unpack its own subgraph
+    {
+        std::string tb = timebase;
+        std::string tp = thread_partitioner;
+        SST::Core::Serialization::serializer ser;
+        ser.start_sizing();
+        ser & tb;
+        ser & tp;
+        ser & Params::keyMapReverse;
+
+        std::vector<char> buffer(ser.size());
+        ser.start_packing(buffer.data(), buffer.size());
+        ser & tb;
+        ser & tp;
+        ser & Params::keyMapReverse;
+
+        Section global;
+        writeSection(fp, path, buffer, global);
+        hdr.global_offset = global.offset;
+        hdr.global_size = global.size;
+    }
+
+    if ( world_size.rank == 1 ) {
+        writeGraph(fp, path, graph, table[0]);
+    }
+    else {
+        // Split the graph for every rank in one pass, then build and
+        // write one subgraph at a time to keep the extra memory small
+        ConfigGraph::RankIndex index;
+        graph->indexRanks(world_size.rank, index);
+        for ( uint32_t i = 0; i < world_size.rank; i++ ) {
+            ConfigGraph* sub = graph->getRankSubGraph(i, index);
+            writeGraph(fp, path, sub, table[i]);
+            delete sub;
+        }
+    }
+
+    if ( fseeko(fp, 0, SEEK_SET) != 0 ||
+         fwrite(&hdr, sizeof(hdr), 1, fp) != 1 ||
+         fwrite(table.data(), sizeof(Section), table.size(), fp) != table.size() ||
+         fclose(fp) != 0 ) {
+        out.fatal(CALL_INFO, 1, "Failed to write binary graph file %s: %s\n", path.c_str(), strerror(errno));
+    }
+
+    uint64_t total = 0;
+    for ( auto& s : table ) total += s.size;
+    out.verbose(CALL_INFO, 1, 0, "# Wrote binary graph for %" PRIu32 " ranks (%" PRIu64 " bytes of graph data) to %s\n",
+                world_size.rank, total, path.c_str());
+}
+
+
+ConfigGraphBinary::ConfigGraphBinary(const std::string& path) :
+    path(path), data(NULL), size(0), min_part(0)
+{
+    Output& out = Output::getDefaultObject();
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if ( fd < 0 ) {
+        out.fatal(CALL_INFO, 1, "Unable to open binary graph file %s: %s\n", path.c_str(), strerror(errno));
+    }
+
+    struct stat sb;
+    if ( fstat(fd, &sb) != 0 ) {
+        out.fatal(CALL_INFO, 1, "Unable to stat binary graph file %s: %s\n", path.c_str(), strerror(errno));
+    }
+    size = sb.st_size;
+    if ( size < sizeof(FileHeader) ) {
+        out.fatal(CALL_INFO, 1, "%s is not an SST binary graph file\n", path.c_str());
+    }
+
+    void* ptr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if ( ptr == MAP_FAILED ) {
+        out.fatal(CALL_INFO, 1, "Unable to map binary graph file %s: %s\n", path.c_str(), strerror(errno));
+    }
+    close(fd);
+    data = static_cast<char*>(ptr);
+
+    const FileHeader* hdr = reinterpret_cast<const FileHeader*>(data);
+    if ( ::memcmp(hdr->magic, graph_magic, sizeof(graph_magic)) != 0 ) {
+        out.fatal(CALL_INFO, 1, "%s is not an SST binary graph file\n", path.c_str());
+    }
+    if ( hdr->byte_order != BYTE_ORDER_MARK ) {
+        out.fatal(CALL_INFO, 1, "Binary graph file %s was written on a machine with a different byte order\n", path.c_str());
+    }
+    if ( hdr->version != VERSION ) {
+        out.fatal(CALL_INFO, 1, "Binary graph file %s is version %" PRIu32 ", but this build of SST reads version %" PRIu32 "\n",
+                  path.c_str(), hdr->version, VERSION);
+    }
+    if ( sizeof(FileHeader) + (uint64_t)hdr->num_ranks * sizeof(Section) > size ) {
+        out.fatal(CALL_INFO, 1, "Binary graph file %s is truncated\n", path.c_str());
+    }
+
+    world_size = RankInfo(hdr->num_ranks, hdr->num_threads);
+    min_part = hdr->min_part;
+
+    Section global = { hdr->global_offset, hdr->global_size };
+    SST::Core::Serialization::serializer ser;
+    ser.start_unpacking(getSectionData(global, "global"), global.size);
+    ser & timebase;
+    ser & thread_partitioner;
+}
+
+ConfigGraphBinary::~ConfigGraphBinary()
+{
+    if ( data != NULL ) {
+        munmap(data, size);
+    }
+}
+
+char*
+ConfigGraphBinary::getSectionData(const Section& section, const char* what)
+{
+    if ( section.offset > size || section.size > size - section.offset ) {
+        Output::getDefaultObject().fatal(CALL_INFO, 1, "Binary graph file %s is truncated (%s section)\n", path.c_str(), what);
+    }
+    return data + section.offset;
+}
+
+ConfigGraph*
+ConfigGraphBinary::loadRank(uint32_t rank)
+{
+    const FileHeader* hdr = reinterpret_cast<const FileHeader*>(data);
+    const Section* table = reinterpret_cast<const Section*>(hdr + 1);
+
+    if ( rank >= hdr->num_ranks ) {
+        Output::getDefaultObject().fatal(CALL_INFO, 1, "Binary graph file %s has no section for rank %" PRIu32 "\n",
+                                         path.c_str(), rank);
+    }
+
+    // Params store their keys as indexes into the global key table,
+    // so it has to match the one the graph was written with
+    {
+        Section global = { hdr->global_offset, hdr->global_size };
+        SST::Core::Serialization::serializer ser;
+        ser.start_unpacking(getSectionData(global, "global"), global.size);
+
+        std::string tb, tp;
+        ser & tb;
+        ser & tp;
+
+        std::lock_guard<SST::Core::ThreadSafe::Spinlock> lock(Params::keyLock);
+        ser & Params::keyMapReverse;
+        Params::keyMap.clear();
+        for ( uint32_t i = 0; i < Params::keyMapReverse.size(); i++ ) {
+            Params::keyMap[Params::keyMapReverse[i]] = i;
+        }
+        Params::nextKeyID = Params::keyMapReverse.size();
+    }
+
+    Section section = table[rank];
+    char* ptr = getSectionData(section, "rank");
+    madvise(ptr, section.size, MADV_SEQUENTIAL);
+
+    ConfigGraph* graph = new ConfigGraph();
+    SST::Core::Serialization::serializer ser;
+    ser.start_unpacking(ptr, section.size);
+    ser & *graph;
+    return graph;
+}
+
+}
+}
@@ -0,0 +1,109 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_CONFIGGRAPHBINARY_H
+#define SST_CORE_CONFIGGRAPHBINARY_H
+
+#include <sst/core/sst_types.h>
+#include <sst/core/rankInfo.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace SST {
+
+class ConfigGraph;
+
+namespace Core {
+
+/**
+ * Reads and writes partitioned ConfigGraphs in a versioned binary
+ * format so that a large model can be restarted without rerunning the
+ * model script and the partitioner.
+ *
+ * The file begins with a fixed header followed by a table with one
+ * section per rank.  Each section holds the serialized subgraph for
+ * that rank, exactly as it would have been distributed at startup, and
+ * starts on a page boundary.  The file is mapped rather than read, so
+ * each rank only pages in the header, the global section (the Params
+ * key table) and its own section.
+ */
+class ConfigGraphBinary {
+
+public:
+    static const uint32_t VERSION = 5;
+
+    /**
+     * Write a partitioned graph.  Called on rank 0 once the graph has
+     * been partitioned and the minimum partition latency is known.
+     * thread_partitioner names the partitioner each rank still has to
+     * run to split its components across its threads, or is empty if
+     * the graph is already partitioned down to threads.
+     */
+    static void write(const std::string& path, ConfigGraph* graph, const RankInfo& world_size,
+                      SimTime_t min_part, const std::string& timebase, const std::string& thread_partitioner);
+
+    /** Map a file written by write() and validate its header */
+    ConfigGraphBinary(const std::string& path);
+    ~ConfigGraphBinary();
+
+    const RankInfo& getWorldSize() const { return world_size; }
+    SimTime_t getMinPartition() const { return min_part; }
+    const std::string& getTimeBase() const { return timebase; }
+    /** The thread partitioner still to be run on each rank, or empty */
+    const std::string& getThreadPartitioner() const { return thread_partitioner; }
+
+    /**
+     * Restore the Params key table and return the subgraph for the
+     * given rank.
+     */
+    ConfigGraph* loadRank(uint32_t rank);
+
+private:
+    struct FileHeader {
+        char     magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint32_t num_ranks;
+        uint32_t num_threads;
+        uint64_t min_part;
+        uint64_t global_offset;
+        uint64_t global_size;
+    };
+
+    struct Section {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+    static const uint64_t SECTION_ALIGN = 4096;
+
+    static uint64_t writeSection(FILE* fp, const std::string& path, std::vector<char>& buffer, Section& section);
+    static void writeGraph(FILE* fp, const std::string& path, ConfigGraph* graph, Section& section);
+
+    char* getSectionData(const Section& section, const char* what);
+
+    std::string path;
+    char* data;
+    size_t size;
+
+    RankInfo world_size;
+    SimTime_t min_part;
+    std::string timebase;
+    std::string thread_partitioner;
+};
+
+}
+}
+
+#endif // SST_CORE_CONFIGGRAPHBINARY_H
@@ -20,6 +20,19 @@
 
 #include <sst/core/activity.h>
 
+/**
+   Use in place of ImplementSerializable() for Events whose data
+   members are all trivially copyable.  Such events cross ranks as a
+   class id plus a raw copy of the object.  When event tracking is
+   compiled in, Event itself carries strings, so fall back to the
+   normal field by field serialization.
+ */
+#ifdef __SST_DEBUG_EVENT_TRACKING__
+#define ImplementTriviallySerializableEvent(obj) ImplementSerializable(obj)
+#else
+#define ImplementTriviallySerializableEvent(obj) ImplementTriviallySerializable(obj)
+#endif
+
 namespace SST {
 
 class Link;
@@ -244,7 +257,7 @@ public:
     
 
 private:
-    ImplementSerializable(SST::NullEvent)
+    ImplementTriviallySerializableEvent(SST::NullEvent)
 
 };
 } //namespace SST
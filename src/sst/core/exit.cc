@@ -24,6 +24,7 @@ REENABLE_WARNING
 #include "sst/core/simulation.h"
 #include "sst/core/timeConverter.h"
 #include "sst/core/stopAction.h"
+#include "sst/core/interprocess/shmcomm.h"
 
 using SST::Core::ThreadSafe::Spinlock;
 
@@ -151,23 +152,29 @@ void Exit::check()
     int value = ( m_refCount > 0 );
     int out;
     
-#ifdef SST_CONFIG_HAVE_MPI
-    if ( !single_rank ) {
-        MPI_Allreduce( &value, &out, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD );
-    }
-    else {
+    if ( single_rank ) {
         out = value;
     }
+    else if ( Core::Interprocess::ShmComm::active() ) {
+        out = Core::Interprocess::ShmComm::get()->allreduce(value, Core::Interprocess::ShmComm::SUM);
+    }
+    else {
+#ifdef SST_CONFIG_HAVE_MPI
+        MPI_Allreduce( &value, &out, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD );
 #else
-    out = value;
+        out = value;
 #endif
+    }
     global_count = out;
     // If out is 0, then it's time to end
     if ( !out ) {
-#ifdef SST_CONFIG_HAVE_MPI
         // Do an all_reduce to get the end_time
-        SimTime_t end_value;
-        if ( !single_rank ) {
+        if ( !single_rank && Core::Interprocess::ShmComm::active() ) {
+            end_time = Core::Interprocess::ShmComm::get()->allreduce(end_time, Core::Interprocess::ShmComm::MAX);
+        }
+#ifdef SST_CONFIG_HAVE_MPI
+        else if ( !single_rank ) {
+            SimTime_t end_value;
             MPI_Allreduce( &end_time, &end_value, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
             end_time = end_value;
         }
@@ -24,6 +24,7 @@
 #include <sst/core/elementinfo.h>
 #include "sst/core/params.h"
 #include "sst/core/linkMap.h"
+#include "sst/core/startupProfiler.h"
 
 // Statistic Output Objects
 #include <sst/core/statapi/statoutputconsole.h>
@@ -742,7 +743,9 @@ Factory::findLibrary(std::string elemlib, bool showErrors)
 
 
     // eli = loader->loadLibrary(elemlib, showErrors);
+    Core::StartupProfiler::Phase load_phase("load_library " + elemlib);
     eli = loadLibrary(elemlib, showErrors);
+    load_phase.end();
     if (NULL == eli) return NULL;
 
 
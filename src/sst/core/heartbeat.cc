@@ -16,6 +16,7 @@
 #include "sst/core/component.h"
 #include "sst/core/simulation.h"
 #include "sst/core/timeConverter.h"
+#include "sst/core/interprocess/shmcomm.h"
 
 #include <sst/core/warnmacros.h>
 #ifdef SST_CONFIG_HAVE_MPI
@@ -74,23 +75,37 @@ void SimulatorHeartbeat::execute( void )
 #endif
     uint64_t max_mempool_size, global_mempool_size, global_active_activities;
     
+    if ( Core::Interprocess::ShmComm::active() ) {
+        typedef Core::Interprocess::ShmComm ShmComm;
+        ShmComm* shm = ShmComm::get();
+        uint64_t local_sync_data_size = Simulation::getSimulation()->getSyncQueueDataSize();
+
+        global_max_tv_depth = shm->allreduce(local_max_tv_depth, ShmComm::MAX);
+        global_max_sync_data_size = shm->allreduce(local_sync_data_size, ShmComm::MAX);
+        global_sync_data_size = shm->allreduce(local_sync_data_size, ShmComm::SUM);
+        max_mempool_size = shm->allreduce(mempool_size, ShmComm::MAX);
+        global_mempool_size = shm->allreduce(mempool_size, ShmComm::SUM);
+        global_active_activities = shm->allreduce(active_activities, ShmComm::SUM);
+    }
+    else {
 #ifdef SST_CONFIG_HAVE_MPI
-    uint64_t local_sync_data_size = Simulation::getSimulation()->getSyncQueueDataSize();
-
-    MPI_Allreduce(&local_max_tv_depth, &global_max_tv_depth, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
-    MPI_Allreduce(&local_sync_data_size, &global_max_sync_data_size, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
-    MPI_Allreduce(&local_sync_data_size, &global_sync_data_size, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
-    MPI_Allreduce(&mempool_size, &max_mempool_size, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
-    MPI_Allreduce(&mempool_size, &global_mempool_size, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
-    MPI_Allreduce(&active_activities, &global_active_activities, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+        uint64_t local_sync_data_size = Simulation::getSimulation()->getSyncQueueDataSize();
+
+        MPI_Allreduce(&local_max_tv_depth, &global_max_tv_depth, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
+        MPI_Allreduce(&local_sync_data_size, &global_max_sync_data_size, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
+        MPI_Allreduce(&local_sync_data_size, &global_sync_data_size, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+        MPI_Allreduce(&mempool_size, &max_mempool_size, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
+        MPI_Allreduce(&mempool_size, &global_mempool_size, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+        MPI_Allreduce(&active_activities, &global_active_activities, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
 #else
-    global_max_tv_depth = local_max_tv_depth;
-    global_max_sync_data_size = 0;
-    global_max_sync_data_size = 0;
-    max_mempool_size = mempool_size;
-    global_mempool_size = mempool_size;
-    global_active_activities = active_activities;
+        global_max_tv_depth = local_max_tv_depth;
+        global_max_sync_data_size = 0;
+        global_max_sync_data_size = 0;
+        max_mempool_size = mempool_size;
+        global_mempool_size = mempool_size;
+        global_active_activities = active_activities;
 #endif
+    }
 
         
     if ( rank == 0 ) {
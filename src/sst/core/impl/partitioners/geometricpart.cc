@@ -0,0 +1,290 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/impl/partitioners/geometricpart.h>
+
+#include <sst/core/warnmacros.h>
+
+#include <sst/core/output.h>
+#include <sst/core/configGraph.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cinttypes>
+#include <deque>
+#include <vector>
+
+using namespace std;
+using namespace SST::IMPL::Partition;
+
+namespace {
+
+/**
+ * Position along a Hilbert curve of a point in dims dimensions with
+ * bits bits per coordinate (John Skilling's transpose algorithm).
+ * X is overwritten.
+ */
+uint64_t hilbertKey(uint32_t X[3], int dims, int bits)
+{
+    if ( dims == 1 ) return X[0];
+
+    uint32_t M = 1u << (bits - 1);
+
+    // Inverse undo
+    for ( uint32_t Q = M; Q > 1; Q >>= 1 ) {
+        uint32_t P = Q - 1;
+        for ( int i = 0; i < dims; i++ ) {
+            if ( X[i] & Q ) {
+                X[0] ^= P;
+            }
+            else {
+                uint32_t t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+
+    // Gray encode
+    for ( int i = 1; i < dims; i++ ) X[i] ^= X[i-1];
+    uint32_t t = 0;
+    for ( uint32_t Q = M; Q > 1; Q >>= 1 ) {
+        if ( X[dims-1] & Q ) t ^= Q - 1;
+    }
+    for ( int i = 0; i < dims; i++ ) X[i] ^= t;
+
+    // Interleave the transposed bits, most significant first
+    uint64_t key = 0;
+    for ( int b = bits - 1; b >= 0; b-- ) {
+        for ( int i = 0; i < dims; i++ ) {
+            key = (key << 1) | ((X[i] >> b) & 1);
+        }
+    }
+    return key;
+}
+
+uint32_t findRoot(std::vector<uint32_t>& parent, uint32_t v)
+{
+    while ( parent[v] != v ) {
+        parent[v] = parent[parent[v]];
+        v = parent[v];
+    }
+    return v;
+}
+
+struct Group {
+    uint64_t key;
+    /** Index of the lowest ID member, which breaks ties in ID order */
+    uint32_t first;
+    double weight;
+    double coords[3];
+    uint32_t members;
+
+    bool operator<(const Group& other) const {
+        if ( key != other.key ) return key < other.key;
+        return first < other.first;
+    }
+};
+
+}
+
+
+SSTGeometricPartition::SSTGeometricPartition(RankInfo mpiranks, RankInfo UNUSED(my_rank), int verbosity) {
+	rankcount = mpiranks;
+	partOutput = new Output("GeometricPartition ", verbosity, 0, SST::Output::STDOUT);
+}
+
+SSTGeometricPartition::~SSTGeometricPartition() {
+	delete partOutput;
+}
+
+void SSTGeometricPartition::performPartition(ConfigGraph* graph) {
+	ConfigComponentMap_t& comps = graph->getComponentMap();
+	ConfigLinkMap_t& links = graph->getLinkMap();
+
+	uint32_t nparts = rankcount.rank * rankcount.thread;
+	uint32_t n = comps.size();
+	if ( n == 0 ) return;
+
+	// Components are numbered by their position in the (ID ordered)
+	// map; link ends are found by binary search
+	std::vector<ComponentId_t> ids;
+	ids.reserve(n);
+	for ( ConfigComponent& comp : comps ) ids.push_back(comp.id);
+	auto indexOf = [&](ComponentId_t id) {
+		return (uint32_t)(std::lower_bound(ids.begin(), ids.end(), COMPONENT_ID_MASK(id)) - ids.begin());
+	};
+
+	std::vector<double> coords(3 * n, 0.0);
+	std::vector<uint8_t> located(n, 0);
+	uint32_t num_located = 0;
+	uint32_t i = 0;
+	for ( ConfigComponent& comp : comps ) {
+		for ( int d = 0; d < 3 && d < (int)comp.coords.size(); d++ ) {
+			coords[3*i + d] = comp.coords[d];
+			if ( comp.coords[d] != 0.0 ) located[i] = 1;
+		}
+		num_located += located[i];
+		i++;
+	}
+
+	// Components without coordinates take them from the nearest
+	// component that has them, found by a breadth first search out
+	// from all the located components at once
+	uint32_t num_inherited = 0;
+	std::vector<uint32_t> parent(n);
+	for ( uint32_t v = 0; v < n; v++ ) parent[v] = v;
+	if ( num_located > 0 && num_located < n ) {
+		std::vector<uint64_t> xadj(n + 1, 0);
+		std::vector<std::pair<uint32_t,uint32_t> > ends;
+		ends.reserve(links.size());
+		for ( ConfigLink& link : links ) {
+			ends.push_back(std::make_pair(indexOf(link.component[0]), indexOf(link.component[1])));
+			xadj[ends.back().first + 1]++;
+			xadj[ends.back().second + 1]++;
+		}
+		for ( uint32_t v = 0; v < n; v++ ) xadj[v+1] += xadj[v];
+		std::vector<uint32_t> adj(xadj[n]);
+		std::vector<uint64_t> fill(xadj.begin(), xadj.end() - 1);
+		for ( auto& e : ends ) {
+			adj[fill[e.first]++] = e.second;
+			adj[fill[e.second]++] = e.first;
+		}
+		std::vector<std::pair<uint32_t,uint32_t> >().swap(ends);
+
+		std::deque<uint32_t> frontier;
+		for ( uint32_t v = 0; v < n; v++ ) {
+			if ( located[v] ) frontier.push_back(v);
+		}
+		while ( !frontier.empty() ) {
+			uint32_t v = frontier.front();
+			frontier.pop_front();
+			for ( uint64_t e = xadj[v]; e < xadj[v+1]; e++ ) {
+				uint32_t u = adj[e];
+				if ( located[u] ) continue;
+				located[u] = 1;
+				std::copy(&coords[3*v], &coords[3*v] + 3, &coords[3*u]);
+				num_inherited++;
+				frontier.push_back(u);
+			}
+		}
+	}
+
+	// Merge the components joined by no-cut links
+	for ( ConfigLink& link : links ) {
+		if ( !link.no_cut ) continue;
+		uint32_t a = findRoot(parent, indexOf(link.component[0]));
+		uint32_t b = findRoot(parent, indexOf(link.component[1]));
+		if ( a == b ) continue;
+		if ( b < a ) std::swap(a, b);
+		parent[b] = a;
+	}
+
+	// Each group sits at the center of its members
+	std::vector<uint32_t> group_of(n);
+	std::vector<Group> groups;
+	double total_weight = 0;
+	i = 0;
+	for ( ConfigComponent& comp : comps ) {
+		uint32_t root = findRoot(parent, i);
+		if ( root == i ) {
+			group_of[i] = groups.size();
+			Group g = { 0, i, 0.0, { 0.0, 0.0, 0.0 }, 0 };
+			groups.push_back(g);
+		}
+		else {
+			group_of[i] = group_of[root];
+		}
+		Group& g = groups[group_of[i]];
+		g.weight += comp.weight;
+		total_weight += comp.weight;
+		for ( int d = 0; d < 3; d++ ) g.coords[d] += coords[3*i + d];
+		g.members++;
+		i++;
+	}
+	std::vector<double>().swap(coords);
+	if ( total_weight <= 0 ) {
+		for ( Group& g : groups ) g.weight = g.members;
+		total_weight = n;
+	}
+
+	// Map the coordinates onto an integer grid, using only the axes
+	// along which the components actually spread out
+	double lo[3], hi[3];
+	for ( int d = 0; d < 3; d++ ) {
+		lo[d] = DBL_MAX;
+		hi[d] = -DBL_MAX;
+	}
+	for ( Group& g : groups ) {
+		for ( int d = 0; d < 3; d++ ) {
+			g.coords[d] /= g.members;
+			lo[d] = std::min(lo[d], g.coords[d]);
+			hi[d] = std::max(hi[d], g.coords[d]);
+		}
+	}
+	int axes[3];
+	int dims = 0;
+	double extent = 0;
+	for ( int d = 0; d < 3; d++ ) {
+		if ( hi[d] > lo[d] ) {
+			axes[dims++] = d;
+			extent = std::max(extent, hi[d] - lo[d]);
+		}
+	}
+
+	if ( dims > 0 ) {
+		int bits = std::min(31, 63 / dims);
+		double scale = (double)((1u << bits) - 1) / extent;
+		for ( Group& g : groups ) {
+			uint32_t X[3];
+			for ( int j = 0; j < dims; j++ ) {
+				X[j] = (uint32_t)((g.coords[axes[j]] - lo[axes[j]]) * scale);
+			}
+			g.key = hilbertKey(X, dims, bits);
+		}
+	}
+	std::sort(groups.begin(), groups.end());
+
+	// Cut the curve into pieces of equal weight.  A group goes to the
+	// part that holds the middle of its weight; the part is recorded
+	// against the group's first member.
+	std::vector<uint32_t> group_part(n);
+	std::vector<double> part_weight(nparts, 0);
+	double before = 0;
+	for ( Group& g : groups ) {
+		uint32_t part = (uint32_t)((before + g.weight / 2) * nparts / total_weight);
+		if ( part >= nparts ) part = nparts - 1;
+		group_part[g.first] = part;
+		part_weight[part] += g.weight;
+		before += g.weight;
+	}
+
+	i = 0;
+	for ( ConfigComponent& comp : comps ) {
+		uint32_t part = group_part[findRoot(parent, i)];
+		comp.setRank(RankInfo(part / rankcount.thread, part % rankcount.thread));
+		i++;
+	}
+
+	if ( partOutput->getVerboseLevel() >= 1 ) {
+		uint64_t cut = 0;
+		for ( ConfigLink& link : links ) {
+			if ( comps[COMPONENT_ID_MASK(link.component[0])].rank != comps[COMPONENT_ID_MASK(link.component[1])].rank ) cut++;
+		}
+		double avg = total_weight / nparts;
+		double max_weight = *std::max_element(part_weight.begin(), part_weight.end());
+		partOutput->verbose(CALL_INFO, 1, 0, "%" PRIu32 " of %" PRIu32 " components have coordinates and %" PRIu32 " more took them from a neighbor; ordering %d dimension(s).\n",
+		                    num_located, n, num_inherited, dims);
+		partOutput->verbose(CALL_INFO, 1, 0, "Geometric partition cut %" PRIu64 " of %zu links; heaviest part is %.1f%% above the average weight.\n",
+		                    cut, links.size(), avg > 0 ? 100.0 * (max_weight - avg) / avg : 0.0);
+	}
+}
@@ -0,0 +1,78 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef SST_CORE_IMPL_PARTITONERS_GEOMETRICPART_H
+#define SST_CORE_IMPL_PARTITONERS_GEOMETRICPART_H
+
+#include <sst/core/sstpart.h>
+#include <sst/core/elementinfo.h>
+
+namespace SST {
+
+class Output;
+
+namespace IMPL {
+namespace Partition {
+
+/**
+Partitions the component graph using the coordinates set on components
+(setCoords() in Python).  Components are ordered along a Hilbert curve
+through their coordinates, and the curve is cut into pieces of equal
+total weight, so nearby components share a rank and thread.  This needs
+only a sort, not a walk of the edges.
+
+A component left at the origin (the default when setCoords() is never
+called) takes the coordinates of the nearest linked component that has
+them.  If no component has coordinates, components are split in ID
+order.  Components joined by no-cut links are kept together.
+*/
+class SSTGeometricPartition : public SST::Partition::SSTPartitioner {
+
+public:
+    SST_ELI_REGISTER_PARTITIONER(
+        SSTGeometricPartition,
+        "sst",
+        "geometric",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Partitions components by their coordinates (setCoords), cutting a Hilbert curve through them into pieces of equal weight.")
+
+protected:
+    /** Number of ranks in the simulation */
+    RankInfo rankcount;
+    /** Output object to print partitioning information */
+    Output* partOutput;
+
+public:
+    /**
+       Creates a new geometric partition scheme.
+       \param rankCount Number of ranks and threads in the simulation
+       \param verbosity The level of information to output
+    */
+    SSTGeometricPartition(RankInfo rankCount, RankInfo my_rank, int verbosity);
+    ~SSTGeometricPartition();
+
+    /**
+       Performs a partition of an SST simulation configuration
+       \param graph The simulation configuration to partition
+    */
+    void performPartition(ConfigGraph* graph) override;
+
+    bool requiresConfigGraph() override { return true; }
+    bool spawnOnAllRanks() override { return false; }
+
+};
+
+}
+}
+}
+
+#endif
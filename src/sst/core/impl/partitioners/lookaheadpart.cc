@@ -0,0 +1,229 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/impl/partitioners/lookaheadpart.h>
+#include <sst/core/impl/partitioners/multilevelpart.h>
+
+#include <sst/core/warnmacros.h>
+
+#include <sst/core/output.h>
+#include <sst/core/configGraph.h>
+#include <sst/core/simulation.h>
+#include <sst/core/timeLord.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <vector>
+
+using namespace std;
+using namespace SST::IMPL::Partition;
+
+namespace {
+
+// A contracted group may hold at most this fraction of a part's share
+// of the weight, which leaves the multilevel partitioner room to
+// balance the parts
+const double MAX_GROUP_FRACTION = 0.5;
+
+struct LatencyEdge {
+    SST::SimTime_t latency;
+    uint32_t v[2];
+
+    bool operator<(const LatencyEdge& other) const { return latency < other.latency; }
+};
+
+class DisjointSets {
+public:
+    DisjointSets(uint32_t n, const std::vector<double>& weight) :
+        parent(n), group_weight(weight), max_weight(0)
+    {
+        for ( uint32_t v = 0; v < n; v++ ) {
+            parent[v] = v;
+            max_weight = std::max(max_weight, weight[v]);
+        }
+    }
+
+    uint32_t find(uint32_t v)
+    {
+        while ( parent[v] != v ) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    }
+
+    void join(uint32_t a, uint32_t b)
+    {
+        a = find(a);
+        b = find(b);
+        if ( a == b ) return;
+        if ( b < a ) std::swap(a, b);
+        parent[b] = a;
+        group_weight[a] += group_weight[b];
+        max_weight = std::max(max_weight, group_weight[a]);
+    }
+
+    /** Weight of the heaviest group */
+    double maxWeight() const { return max_weight; }
+
+private:
+    std::vector<uint32_t> parent;
+    std::vector<double> group_weight;
+    double max_weight;
+};
+
+/** Join the endpoints of the first count edges (sorted by latency) */
+void contract(DisjointSets& sets, const std::vector<LatencyEdge>& edges, size_t count)
+{
+    for ( size_t i = 0; i < count; i++ ) sets.join(edges[i].v[0], edges[i].v[1]);
+}
+
+}
+
+
+SSTLookaheadPartition::SSTLookaheadPartition(RankInfo mpiranks, RankInfo my_rank, int verbosity) :
+	rankcount(mpiranks),
+	myrank(my_rank),
+	verbosity(verbosity)
+{
+	partOutput = new Output("LookaheadPartition ", verbosity, 0, SST::Output::STDOUT);
+}
+
+SSTLookaheadPartition::~SSTLookaheadPartition() {
+	delete partOutput;
+}
+
+void SSTLookaheadPartition::performPartition(PartitionGraph* graph) {
+	PartitionComponentMap_t& compMap = graph->getComponentMap();
+	PartitionLinkMap_t& linkMap = graph->getLinkMap();
+
+	uint32_t nparts = rankcount.rank * rankcount.thread;
+	uint32_t n = graph->getNumComponents();
+
+	std::vector<ComponentId_t> ids;
+	std::vector<double> weight;
+	ids.reserve(n);
+	weight.reserve(n);
+	double total = 0;
+	for ( PartitionComponent& comp : compMap ) {
+		ids.push_back(comp.id);
+		weight.push_back(comp.weight);
+		total += comp.weight;
+	}
+	if ( total <= 0 ) {
+		weight.assign(n, 1.0);
+		total = n;
+	}
+
+	std::vector<LatencyEdge> edges;
+	edges.reserve(linkMap.size());
+	for ( PartitionLink& link : linkMap ) {
+		LatencyEdge edge;
+		edge.latency = link.getMinLatency();
+		for ( int i = 0; i < 2; i++ ) {
+			edge.v[i] = std::lower_bound(ids.begin(), ids.end(), link.component[i]) - ids.begin();
+		}
+		if ( edge.v[0] == edge.v[1] ) continue;
+		edges.push_back(edge);
+	}
+	std::sort(edges.begin(), edges.end());
+
+	// Find the largest number of lowest latency links that can be
+	// contracted without any group getting too heavy.  Contracting
+	// more links only makes groups heavier, so binary search on the
+	// boundaries between distinct latencies.
+	double limit = MAX_GROUP_FRACTION * total / nparts;
+	std::vector<size_t> bounds;
+	for ( size_t i = 1; i < edges.size(); i++ ) {
+		if ( edges[i].latency != edges[i-1].latency ) bounds.push_back(i);
+	}
+	bounds.push_back(edges.size());
+
+	size_t contracted = 0;
+	size_t lo = 0, hi = bounds.size();
+	while ( lo < hi ) {
+		size_t mid = (lo + hi) / 2;
+		DisjointSets sets(n, weight);
+		contract(sets, edges, bounds[mid]);
+		// A single component heavier than the limit can't be helped
+		if ( sets.maxWeight() <= std::max(limit, *std::max_element(weight.begin(), weight.end())) ) {
+			contracted = bounds[mid];
+			lo = mid + 1;
+		}
+		else {
+			hi = mid;
+		}
+	}
+
+	SimTime_t threshold = contracted < edges.size() ? edges[contracted].latency : MAX_SIMTIME_T;
+	partOutput->verbose(CALL_INFO, 1, 0, "Contracting %zu of %zu links with latency below %" PRIu64 " core time units.\n",
+	                    contracted, edges.size(), threshold);
+
+	DisjointSets sets(n, weight);
+	contract(sets, edges, contracted);
+	std::vector<LatencyEdge>().swap(edges);
+
+	// Build the contracted graph.  Each group is represented by its
+	// lowest ID member, which keeps both maps in ID order.
+	PartitionGraph contracted_graph;
+	PartitionComponentMap_t& groups = contracted_graph.getComponentMap();
+	uint32_t i = 0;
+	for ( PartitionComponent& comp : compMap ) {
+		uint32_t root = sets.find(i);
+		if ( root == i ) groups.push_back(PartitionComponent(comp.id));
+		groups[ids[root]].weight += weight[i];
+		i++;
+	}
+	PartitionLinkMap_t& group_links = contracted_graph.getLinkMap();
+	for ( PartitionLink& link : linkMap ) {
+		PartitionLink group_link = link;
+		for ( int j = 0; j < 2; j++ ) {
+			uint32_t v = std::lower_bound(ids.begin(), ids.end(), link.component[j]) - ids.begin();
+			group_link.component[j] = ids[sets.find(v)];
+		}
+		if ( group_link.component[0] != group_link.component[1] ) group_links.push_back(group_link);
+	}
+
+	SSTMultilevelPartition multilevel(rankcount, myrank, verbosity);
+	multilevel.performPartition(&contracted_graph);
+
+	i = 0;
+	for ( PartitionComponent& comp : compMap ) {
+		comp.rank = groups[ids[sets.find(i)]].rank;
+		i++;
+	}
+
+	// Report the lookahead that was achieved, both between ranks (the
+	// sync period) and between threads
+	SimTime_t min_rank = MAX_SIMTIME_T;
+	SimTime_t min_thread = MAX_SIMTIME_T;
+	for ( PartitionLink& link : linkMap ) {
+		const RankInfo& r0 = compMap[link.component[0]].rank;
+		const RankInfo& r1 = compMap[link.component[1]].rank;
+		if ( r0.rank != r1.rank ) min_rank = std::min(min_rank, link.getMinLatency());
+		else if ( r0.thread != r1.thread ) min_thread = std::min(min_thread, link.getMinLatency());
+	}
+
+	UnitAlgebra time_base = Simulation::getTimeLord()->getTimeBase();
+	if ( min_rank == MAX_SIMTIME_T ) {
+		partOutput->verbose(CALL_INFO, 1, 0, "No links cross a rank boundary.\n");
+	}
+	else {
+		UnitAlgebra period = time_base * min_rank;
+		partOutput->verbose(CALL_INFO, 1, 0, "Minimum cross-rank link latency (min_part) is %s, predicting %.6g rank syncs per simulated microsecond.\n",
+		                    period.toStringBestSI().c_str(), 1e-6 / period.getValue().toDouble());
+	}
+	if ( min_thread != MAX_SIMTIME_T ) {
+		partOutput->verbose(CALL_INFO, 1, 0, "Minimum cross-thread link latency is %s.\n",
+		                    (time_base * min_thread).toStringBestSI().c_str());
+	}
+}
@@ -0,0 +1,79 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef SST_CORE_IMPL_PARTITONERS_LOOKAHEADPART_H
+#define SST_CORE_IMPL_PARTITONERS_LOOKAHEADPART_H
+
+#include <sst/core/sstpart.h>
+#include <sst/core/elementinfo.h>
+
+namespace SST {
+
+class Output;
+
+namespace IMPL {
+namespace Partition {
+
+/**
+Partitions the component graph to make the smallest latency of any cut
+link (min_part, which sets the synchronization period between ranks) as
+large as possible.  Every link with a latency below a threshold is
+contracted, so those links can never be cut.  The threshold is the
+largest link latency for which no contracted group grows too heavy to
+balance.  The contracted graph is then split by the multilevel
+partitioner, which minimizes the number of remaining cut links.
+*/
+class SSTLookaheadPartition : public SST::Partition::SSTPartitioner {
+
+public:
+    SST_ELI_REGISTER_PARTITIONER(
+        SSTLookaheadPartition,
+        "sst",
+        "lookahead",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Partitions the graph so that the lowest latency links are never cut, maximizing the synchronization period (min_part) between ranks.")
+
+protected:
+    /** Number of ranks in the simulation */
+    RankInfo rankcount;
+    /** This rank */
+    RankInfo myrank;
+    /** Verbosity to pass on to the multilevel partitioner */
+    int verbosity;
+    /** Output object to print partitioning information */
+    Output* partOutput;
+
+public:
+    /**
+       Creates a new lookahead maximizing partition scheme.
+       \param rankCount Number of ranks and threads in the simulation
+       \param verbosity The level of information to output
+    */
+    SSTLookaheadPartition(RankInfo rankCount, RankInfo my_rank, int verbosity);
+    ~SSTLookaheadPartition();
+
+    /**
+       Performs a partition of an SST simulation configuration
+       \param graph The simulation configuration to partition
+    */
+    void performPartition(PartitionGraph* graph) override;
+
+    bool requiresConfigGraph() override { return false; }
+    bool spawnOnAllRanks() override { return false; }
+
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,739 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/impl/partitioners/multilevelpart.h>
+
+#include <sst/core/warnmacros.h>
+
+#include <sst/core/output.h>
+#include <sst/core/configGraph.h>
+
+#ifdef SST_CONFIG_HAVE_MPI
+DISABLE_WARN_MISSING_OVERRIDE
+#include <mpi.h>
+REENABLE_WARNING
+#endif
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <deque>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace SST::IMPL::Partition;
+
+namespace {
+
+typedef int64_t EdgeWeight;
+
+const uint32_t NONE = UINT32_MAX;
+
+// Stop coarsening once a graph is this small
+const uint32_t COARSEN_TO = 120;
+// Number of graph growing attempts for the initial bisection
+const int INIT_TRIALS = 8;
+// Refinement passes per level
+const int REFINE_PASSES = 8;
+// Allowed imbalance of the final parts
+const double IMBALANCE = 0.03;
+// Link weights are rounded to integer multiples of 1/EDGE_SCALE
+const double EDGE_SCALE = 16;
+
+/** Graph in compressed sparse row form */
+struct Graph {
+    std::vector<uint64_t> xadj;
+    std::vector<uint32_t> adj;
+    std::vector<EdgeWeight> ewgt;
+    std::vector<double> vwgt;
+    /** Vertex index in the original graph (not kept for coarse graphs) */
+    std::vector<uint32_t> label;
+
+    double total_weight;
+    /** Largest total edge weight on one vertex; bounds the FM gains */
+    EdgeWeight max_degree;
+
+    uint32_t size() const { return vwgt.size(); }
+
+    void finish()
+    {
+        total_weight = 0;
+        max_degree = 0;
+        for ( uint32_t v = 0; v < size(); v++ ) {
+            total_weight += vwgt[v];
+            EdgeWeight degree = 0;
+            for ( uint64_t e = xadj[v]; e < xadj[v+1]; e++ ) degree += ewgt[e];
+            max_degree = std::max(max_degree, degree);
+        }
+    }
+};
+
+
+/**
+ * Vertices ordered by move gain.  There is one bucket for each
+ * possible gain, so insert, remove and finding the best vertex are all
+ * constant time (amortized for the last).
+ */
+class GainBuckets {
+public:
+    void reset(uint32_t n, EdgeWeight max_gain)
+    {
+        offset = max_gain;
+        head.assign(2 * max_gain + 1, NONE);
+        next.resize(n);
+        prev.resize(n);
+        key.resize(n);
+        queued.assign(n, 0);
+        top = -1;
+        count = 0;
+    }
+
+    bool empty() const { return count == 0; }
+    bool contains(uint32_t v) const { return queued[v]; }
+    EdgeWeight gain(uint32_t v) const { return key[v] - offset; }
+
+    void insert(uint32_t v, EdgeWeight gain)
+    {
+        int64_t b = gain + offset;
+        key[v] = b;
+        prev[v] = NONE;
+        next[v] = head[b];
+        if ( head[b] != NONE ) prev[head[b]] = v;
+        head[b] = v;
+        queued[v] = 1;
+        if ( b > top ) top = b;
+        count++;
+    }
+
+    void remove(uint32_t v)
+    {
+        int64_t b = key[v];
+        if ( prev[v] != NONE ) next[prev[v]] = next[v];
+        else head[b] = next[v];
+        if ( next[v] != NONE ) prev[next[v]] = prev[v];
+        queued[v] = 0;
+        count--;
+    }
+
+    void update(uint32_t v, EdgeWeight gain)
+    {
+        if ( key[v] == gain + offset ) return;
+        remove(v);
+        insert(v, gain);
+    }
+
+    /** Vertex with the highest gain; the queue must not be empty */
+    uint32_t best()
+    {
+        while ( head[top] == NONE ) top--;
+        return head[top];
+    }
+
+private:
+    int64_t offset;
+    int64_t top;
+    size_t count;
+    std::vector<uint32_t> head;
+    std::vector<uint32_t> next;
+    std::vector<uint32_t> prev;
+    std::vector<int64_t> key;
+    std::vector<uint8_t> queued;
+};
+
+
+/** A two way partition of a Graph and the state FM needs */
+struct Bisection {
+    std::vector<uint8_t> where;
+    /** Edge weight to the vertex's own side (internal) and the other side (external) */
+    std::vector<EdgeWeight> id;
+    std::vector<EdgeWeight> ed;
+    double pw[2];
+    double max_pw[2];
+    EdgeWeight cut;
+
+    double overflow() const
+    {
+        return std::max(0.0, pw[0] - max_pw[0]) + std::max(0.0, pw[1] - max_pw[1]);
+    }
+
+    void computeGains(const Graph& g)
+    {
+        uint32_t n = g.size();
+        id.assign(n, 0);
+        ed.assign(n, 0);
+        pw[0] = pw[1] = 0;
+        cut = 0;
+        for ( uint32_t v = 0; v < n; v++ ) {
+            pw[where[v]] += g.vwgt[v];
+            for ( uint64_t e = g.xadj[v]; e < g.xadj[v+1]; e++ ) {
+                if ( where[g.adj[e]] == where[v] ) id[v] += g.ewgt[e];
+                else ed[v] += g.ewgt[e];
+            }
+            cut += ed[v];
+        }
+        cut /= 2;
+    }
+
+    /** Move v to the other side, updating the gains of its neighbors */
+    template <typename Visit>
+    void move(const Graph& g, uint32_t v, Visit visit)
+    {
+        int from = where[v];
+        int to = 1 - from;
+        cut -= ed[v] - id[v];
+        pw[from] -= g.vwgt[v];
+        pw[to] += g.vwgt[v];
+        where[v] = to;
+        std::swap(id[v], ed[v]);
+        for ( uint64_t e = g.xadj[v]; e < g.xadj[v+1]; e++ ) {
+            uint32_t u = g.adj[e];
+            if ( where[u] == to ) {
+                id[u] += g.ewgt[e];
+                ed[u] -= g.ewgt[e];
+            }
+            else {
+                id[u] -= g.ewgt[e];
+                ed[u] += g.ewgt[e];
+            }
+            visit(u);
+        }
+    }
+
+    bool betterThan(double over, EdgeWeight other_cut) const
+    {
+        double mine = overflow();
+        return mine < over || (mine == over && cut < other_cut);
+    }
+};
+
+
+/**
+ * One Fiduccia-Mattheyses pass.  Moves the best unlocked vertex at a
+ * time, keeping both sides within their weight limits, until enough
+ * moves in a row have not improved the cut, then rolls back to the
+ * best state seen.  If the bisection starts out of balance, every
+ * vertex is a candidate and balance counts before cut.
+ */
+void fmPass(const Graph& g, Bisection& b, GainBuckets q[2], std::vector<uint8_t>& locked)
+{
+    uint32_t n = g.size();
+    bool balancing = b.overflow() > 0;
+
+    q[0].reset(n, g.max_degree);
+    q[1].reset(n, g.max_degree);
+    locked.assign(n, 0);
+    for ( uint32_t v = 0; v < n; v++ ) {
+        if ( balancing || b.ed[v] > 0 ) q[b.where[v]].insert(v, b.ed[v] - b.id[v]);
+    }
+
+    std::vector<uint32_t> moves;
+    double best_over = b.overflow();
+    EdgeWeight best_cut = b.cut;
+    size_t best_len = 0;
+    size_t limit = std::min<size_t>(std::max<size_t>(n / 100, 25), 250);
+
+    auto visit = [&](uint32_t u) {
+        if ( locked[u] ) return;
+        GainBuckets& uq = q[b.where[u]];
+        if ( uq.contains(u) ) {
+            if ( !balancing && b.ed[u] == 0 ) uq.remove(u);
+            else uq.update(u, b.ed[u] - b.id[u]);
+        }
+        else if ( b.ed[u] > 0 ) {
+            uq.insert(u, b.ed[u] - b.id[u]);
+        }
+    };
+
+    while ( true ) {
+        int from = -1;
+        if ( b.overflow() > 0 ) {
+            from = (b.pw[0] - b.max_pw[0] > b.pw[1] - b.max_pw[1]) ? 0 : 1;
+            if ( q[from].empty() ) break;
+        }
+        else {
+            // Take the better of the two sides' best moves that keep
+            // the destination within its limit
+            EdgeWeight best_gain = 0;
+            for ( int s = 0; s < 2; s++ ) {
+                if ( q[s].empty() ) continue;
+                uint32_t v = q[s].best();
+                if ( b.pw[1-s] + g.vwgt[v] > b.max_pw[1-s] ) continue;
+                if ( from == -1 || q[s].gain(v) > best_gain ) {
+                    from = s;
+                    best_gain = q[s].gain(v);
+                }
+            }
+            if ( from == -1 ) break;
+        }
+
+        uint32_t v = q[from].best();
+        q[from].remove(v);
+        locked[v] = 1;
+        b.move(g, v, visit);
+        moves.push_back(v);
+
+        if ( b.betterThan(best_over, best_cut) ) {
+            best_over = b.overflow();
+            best_cut = b.cut;
+            best_len = moves.size();
+        }
+        else if ( moves.size() - best_len > limit ) {
+            break;
+        }
+    }
+
+    // Undo the moves made after the best state
+    auto ignore = [](uint32_t) {};
+    while ( moves.size() > best_len ) {
+        b.move(g, moves.back(), ignore);
+        moves.pop_back();
+    }
+}
+
+void refine(const Graph& g, Bisection& b)
+{
+    GainBuckets q[2];
+    std::vector<uint8_t> locked;
+    for ( int pass = 0; pass < REFINE_PASSES; pass++ ) {
+        double old_over = b.overflow();
+        EdgeWeight old_cut = b.cut;
+        fmPass(g, b, q, locked);
+        if ( !b.betterThan(old_over, old_cut) ) break;
+    }
+}
+
+
+/**
+ * Match each vertex with the unmatched neighbor it shares the heaviest
+ * edge with, and merge the pairs into a coarser graph.  cmap gets the
+ * coarse vertex of each fine vertex.
+ */
+Graph coarsen(const Graph& g, std::mt19937& rng, double max_vwgt, std::vector<uint32_t>& cmap)
+{
+    uint32_t n = g.size();
+    std::vector<uint32_t> match(n, NONE);
+    std::vector<uint32_t> order(n);
+    for ( uint32_t v = 0; v < n; v++ ) order[v] = v;
+    std::shuffle(order.begin(), order.end(), rng);
+
+    cmap.assign(n, NONE);
+    std::vector<uint32_t> first;
+    for ( uint32_t v : order ) {
+        if ( match[v] != NONE ) continue;
+        uint32_t best = v;
+        EdgeWeight best_w = -1;
+        for ( uint64_t e = g.xadj[v]; e < g.xadj[v+1]; e++ ) {
+            uint32_t u = g.adj[e];
+            if ( match[u] != NONE || g.vwgt[v] + g.vwgt[u] > max_vwgt ) continue;
+            if ( g.ewgt[e] > best_w || (g.ewgt[e] == best_w && g.vwgt[u] < g.vwgt[best]) ) {
+                best = u;
+                best_w = g.ewgt[e];
+            }
+        }
+        match[v] = best;
+        match[best] = v;
+        cmap[v] = cmap[best] = first.size();
+        first.push_back(v);
+    }
+
+    Graph c;
+    uint32_t cn = first.size();
+    c.xadj.resize(cn + 1);
+    c.vwgt.resize(cn);
+    c.adj.reserve(g.adj.size() / 2);
+    c.ewgt.reserve(g.adj.size() / 2);
+
+    // Merge the members' edges, using pos to find an existing edge to
+    // the same coarse neighbor
+    std::vector<uint64_t> pos(cn, UINT64_MAX);
+    c.xadj[0] = 0;
+    for ( uint32_t cv = 0; cv < cn; cv++ ) {
+        uint32_t members[2] = { first[cv], match[first[cv]] };
+        int count = members[0] == members[1] ? 1 : 2;
+        uint64_t start = c.adj.size();
+        c.vwgt[cv] = 0;
+        for ( int i = 0; i < count; i++ ) {
+            uint32_t v = members[i];
+            c.vwgt[cv] += g.vwgt[v];
+            for ( uint64_t e = g.xadj[v]; e < g.xadj[v+1]; e++ ) {
+                uint32_t cu = cmap[g.adj[e]];
+                if ( cu == cv ) continue;
+                if ( pos[cu] == UINT64_MAX ) {
+                    pos[cu] = c.adj.size();
+                    c.adj.push_back(cu);
+                    c.ewgt.push_back(g.ewgt[e]);
+                }
+                else {
+                    c.ewgt[pos[cu]] += g.ewgt[e];
+                }
+            }
+        }
+        for ( uint64_t e = start; e < c.adj.size(); e++ ) pos[c.adj[e]] = UINT64_MAX;
+        c.xadj[cv+1] = c.adj.size();
+    }
+    c.finish();
+    return c;
+}
+
+
+/**
+ * Bisect a small graph by growing side 0 breadth first from a random
+ * vertex until it reaches its target weight, refining each attempt and
+ * keeping the best.
+ */
+void initialBisection(const Graph& g, Bisection& best, double target0, std::mt19937& rng)
+{
+    uint32_t n = g.size();
+    Bisection b;
+    b.max_pw[0] = best.max_pw[0];
+    b.max_pw[1] = best.max_pw[1];
+    bool have_best = false;
+    std::vector<uint8_t> seen;
+    std::deque<uint32_t> frontier;
+
+    for ( int trial = 0; trial < INIT_TRIALS; trial++ ) {
+        b.where.assign(n, 1);
+        seen.assign(n, 0);
+        frontier.clear();
+        double pw0 = 0;
+        uint32_t next_seed = rng() % n;
+
+        while ( pw0 < target0 ) {
+            if ( frontier.empty() ) {
+                // Start a new region (the graph may not be connected)
+                uint32_t tries = 0;
+                while ( seen[next_seed] && tries++ < n ) next_seed = (next_seed + 1) % n;
+                if ( seen[next_seed] ) break;
+                seen[next_seed] = 1;
+                frontier.push_back(next_seed);
+            }
+            uint32_t v = frontier.front();
+            frontier.pop_front();
+            b.where[v] = 0;
+            pw0 += g.vwgt[v];
+            for ( uint64_t e = g.xadj[v]; e < g.xadj[v+1]; e++ ) {
+                uint32_t u = g.adj[e];
+                if ( !seen[u] ) {
+                    seen[u] = 1;
+                    frontier.push_back(u);
+                }
+            }
+        }
+
+        b.computeGains(g);
+        refine(g, b);
+        if ( !have_best || b.betterThan(best.overflow(), best.cut) ) {
+            best = b;
+            have_best = true;
+        }
+    }
+}
+
+
+/** Split g into two graphs along a bisection, dropping the cut edges */
+void split(const Graph& g, const std::vector<uint8_t>& where, Graph sides[2])
+{
+    uint32_t n = g.size();
+    std::vector<uint32_t> index(n);
+    for ( int s = 0; s < 2; s++ ) {
+        sides[s].xadj.assign(1, 0);
+    }
+    for ( uint32_t v = 0; v < n; v++ ) {
+        Graph& side = sides[where[v]];
+        index[v] = side.vwgt.size();
+        side.vwgt.push_back(g.vwgt[v]);
+        side.label.push_back(g.label[v]);
+    }
+    for ( uint32_t v = 0; v < n; v++ ) {
+        Graph& side = sides[where[v]];
+        for ( uint64_t e = g.xadj[v]; e < g.xadj[v+1]; e++ ) {
+            uint32_t u = g.adj[e];
+            if ( where[u] != where[v] ) continue;
+            side.adj.push_back(index[u]);
+            side.ewgt.push_back(g.ewgt[e]);
+        }
+        side.xadj.push_back(side.adj.size());
+    }
+    sides[0].finish();
+    sides[1].finish();
+}
+
+
+/** Multilevel bisection of g, with side 0 getting frac of the weight */
+Bisection bisect(const Graph& g, double frac, double imbalance, std::mt19937& rng)
+{
+    // Coarsen.  A deque keeps references to earlier levels valid.
+    std::deque<Graph> levels;
+    std::deque<std::vector<uint32_t> > cmaps;
+    const Graph* cur = &g;
+    double max_vwgt = 1.5 * g.total_weight / COARSEN_TO;
+    while ( cur->size() > COARSEN_TO ) {
+        std::vector<uint32_t> cmap;
+        Graph c = coarsen(*cur, rng, max_vwgt, cmap);
+        if ( c.size() > 0.95 * cur->size() ) break;
+        levels.push_back(std::move(c));
+        cmaps.push_back(std::move(cmap));
+        cur = &levels.back();
+    }
+
+    Bisection b;
+    double target0 = frac * g.total_weight;
+    b.max_pw[0] = target0 * (1.0 + imbalance);
+    b.max_pw[1] = (g.total_weight - target0) * (1.0 + imbalance);
+    initialBisection(*cur, b, target0, rng);
+
+    // Project back to each finer level and refine
+    for ( size_t level = levels.size(); level > 0; level-- ) {
+        const Graph& fine = level > 1 ? levels[level - 2] : g;
+        const std::vector<uint32_t>& cmap = cmaps[level - 1];
+        std::vector<uint8_t> where(fine.size());
+        for ( uint32_t v = 0; v < fine.size(); v++ ) where[v] = b.where[cmap[v]];
+        b.where.swap(where);
+        levels.pop_back();
+        b.computeGains(fine);
+        refine(fine, b);
+    }
+    return b;
+}
+
+
+/** Recursively bisect g into nparts parts numbered from first_part */
+void partition(Graph& g, uint32_t first_part, uint32_t nparts, double imbalance,
+               std::mt19937& rng, std::vector<uint32_t>& part)
+{
+    if ( nparts == 1 || g.size() <= 1 ) {
+        for ( uint32_t v = 0; v < g.size(); v++ ) part[g.label[v]] = first_part;
+        return;
+    }
+
+    uint32_t nparts0 = nparts / 2;
+    Bisection b = bisect(g, (double)nparts0 / nparts, imbalance, rng);
+
+    Graph sides[2];
+    split(g, b.where, sides);
+    // Nothing below needs this level's graph
+    g = Graph();
+
+    partition(sides[0], first_part, nparts0, imbalance, rng, part);
+    partition(sides[1], first_part + nparts0, nparts - nparts0, imbalance, rng, part);
+}
+
+#ifdef SST_CONFIG_HAVE_MPI
+/** Send g from rank 0 to the other ranks */
+void broadcastGraph(Graph& g)
+{
+    uint64_t sizes[2] = { g.size(), g.adj.size() };
+    MPI_Bcast(sizes, 2, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+    uint32_t n = sizes[0];
+    g.xadj.resize(n + 1);
+    g.adj.resize(sizes[1]);
+    g.ewgt.resize(sizes[1]);
+    g.vwgt.resize(n);
+    MPI_Bcast(g.xadj.data(), (int)(n + 1), MPI_UINT64_T, 0, MPI_COMM_WORLD);
+    MPI_Bcast(g.adj.data(), (int)sizes[1], MPI_UINT32_T, 0, MPI_COMM_WORLD);
+    MPI_Bcast(g.ewgt.data(), (int)sizes[1], MPI_INT64_T, 0, MPI_COMM_WORLD);
+    MPI_Bcast(g.vwgt.data(), (int)n, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    g.label.resize(n);
+    for ( uint32_t v = 0; v < n; v++ ) g.label[v] = v;
+    g.finish();
+}
+
+/**
+ * Recursively bisect g into nparts parts numbered from first_part,
+ * shared among the ranks of comm.  Every rank bisects the whole graph
+ * with its own random choices and the best bisection is kept.  The
+ * ranks then split in proportion to the parts on each side, and each
+ * group goes on with its side only, so the work below the first level
+ * is divided among the ranks.
+ */
+void partitionParallel(Graph& g, uint32_t first_part, uint32_t nparts, double imbalance,
+                       std::mt19937& rng, std::vector<uint32_t>& part, MPI_Comm comm)
+{
+    int me, procs;
+    MPI_Comm_rank(comm, &me);
+    MPI_Comm_size(comm, &procs);
+    if ( procs == 1 || nparts == 1 || g.size() <= 1 ) {
+        partition(g, first_part, nparts, imbalance, rng, part);
+        return;
+    }
+
+    uint32_t nparts0 = nparts / 2;
+    Bisection b = bisect(g, (double)nparts0 / nparts, imbalance, rng);
+
+    // Pick the best bisection; ties go to the lowest rank
+    double mine[2] = { b.overflow(), (double)b.cut };
+    std::vector<double> all(2 * procs);
+    MPI_Allgather(mine, 2, MPI_DOUBLE, all.data(), 2, MPI_DOUBLE, comm);
+    int best = 0;
+    for ( int r = 1; r < procs; r++ ) {
+        if ( all[2*r] < all[2*best] || (all[2*r] == all[2*best] && all[2*r+1] < all[2*best+1]) ) best = r;
+    }
+    MPI_Bcast(b.where.data(), (int)g.size(), MPI_UINT8_T, best, comm);
+
+    Graph sides[2];
+    split(g, b.where, sides);
+    g = Graph();
+
+    int procs0 = (int)std::lround((double)procs * nparts0 / nparts);
+    procs0 = std::max(1, std::min(procs - 1, procs0));
+    int side = me < procs0 ? 0 : 1;
+    MPI_Comm sub;
+    MPI_Comm_split(comm, side, me, &sub);
+    if ( side == 0 ) {
+        sides[1] = Graph();
+        partitionParallel(sides[0], first_part, nparts0, imbalance, rng, part, sub);
+    }
+    else {
+        sides[0] = Graph();
+        partitionParallel(sides[1], first_part + nparts0, nparts - nparts0, imbalance, rng, part, sub);
+    }
+    MPI_Comm_free(&sub);
+}
+#endif
+
+}
+
+
+SSTMultilevelPartition::SSTMultilevelPartition(RankInfo mpiranks, RankInfo UNUSED(my_rank), int verbosity) {
+	rankcount = mpiranks;
+	distributed = false;
+	partOutput = new Output("MultilevelPartition ", verbosity, 0, SST::Output::STDOUT);
+}
+
+SSTMultilevelPartition::~SSTMultilevelPartition() {
+	delete partOutput;
+}
+
+void SSTMultilevelPartition::performPartition(PartitionGraph* graph) {
+	PartitionComponentMap_t& compMap = graph->getComponentMap();
+	PartitionLinkMap_t& linkMap = graph->getLinkMap();
+
+	uint32_t nparts = rankcount.rank * rankcount.thread;
+	uint32_t n = graph->getNumComponents();
+
+	// Only rank 0 has the graph; in a distributed partition the other
+	// ranks are sent the adjacency lists built below
+	int me = 0, procs = 1;
+#ifdef SST_CONFIG_HAVE_MPI
+	// MPI is not initialized with --shm-ranks, where rank 0
+	// partitions alone
+	int mpi_initialized = 0;
+	MPI_Initialized(&mpi_initialized);
+	if ( distributed && mpi_initialized ) {
+		MPI_Comm_rank(MPI_COMM_WORLD, &me);
+		MPI_Comm_size(MPI_COMM_WORLD, &procs);
+	}
+#endif
+
+	if ( me == 0 ) {
+		partOutput->verbose(CALL_INFO, 1, 0, "Performing a multilevel partition of %" PRIu32 " components into %" PRIu32 " parts on %d rank(s).\n", n, nparts, procs);
+	}
+
+	// Component IDs are in sorted order in the map, so a link end can
+	// be turned into a vertex index by binary search
+	std::vector<ComponentId_t> ids;
+	ids.reserve(n);
+	Graph g;
+	g.vwgt.reserve(n);
+	for ( PartitionComponent& comp : compMap ) {
+		ids.push_back(comp.id);
+		g.vwgt.push_back(comp.weight);
+		g.label.push_back(g.label.size());
+	}
+	double total = 0;
+	for ( double w : g.vwgt ) total += w;
+	if ( total <= 0 ) g.vwgt.assign(n, 1.0);
+
+	// Build the adjacency lists, merging parallel links into one
+	// edge with their combined weight
+	typedef std::pair<std::pair<uint32_t,uint32_t>,EdgeWeight> WeightedEnd;
+	std::vector<WeightedEnd> edges;
+	edges.reserve(2 * linkMap.size());
+	for ( PartitionLink& link : linkMap ) {
+		uint32_t v[2];
+		for ( int i = 0; i < 2; i++ ) {
+			v[i] = std::lower_bound(ids.begin(), ids.end(), link.component[i]) - ids.begin();
+		}
+		if ( v[0] == v[1] || v[0] >= n || v[1] >= n ) continue;
+		EdgeWeight w = std::max<EdgeWeight>(1, std::llround(link.weight * EDGE_SCALE));
+		edges.push_back(std::make_pair(std::make_pair(v[0], v[1]), w));
+		edges.push_back(std::make_pair(std::make_pair(v[1], v[0]), w));
+	}
+	std::sort(edges.begin(), edges.end());
+
+	g.xadj.assign(n + 1, 0);
+	for ( size_t i = 0; i < edges.size(); i++ ) {
+		if ( i > 0 && edges[i].first == edges[i-1].first ) {
+			g.ewgt.back() += edges[i].second;
+			continue;
+		}
+		g.adj.push_back(edges[i].first.second);
+		g.ewgt.push_back(edges[i].second);
+		g.xadj[edges[i].first.first + 1] = g.adj.size();
+	}
+	for ( uint32_t v = 0; v < n; v++ ) {
+		if ( g.xadj[v+1] < g.xadj[v] ) g.xadj[v+1] = g.xadj[v];
+	}
+	std::vector<WeightedEnd>().swap(edges);
+	g.finish();
+
+	// Split the allowed imbalance evenly over the levels of bisection
+	int depth = 0;
+	while ( (1u << depth) < nparts ) depth++;
+	double imbalance = depth > 0 ? std::pow(1.0 + IMBALANCE, 1.0 / depth) - 1.0 : IMBALANCE;
+
+	std::vector<uint32_t> part(n, 0);
+	std::mt19937 rng(1);
+#ifdef SST_CONFIG_HAVE_MPI
+	if ( procs > 1 ) {
+		broadcastGraph(g);
+		n = g.size();
+		part.assign(n, 0);
+		rng.seed(1 + me);
+		partitionParallel(g, 0, nparts, imbalance, rng, part, MPI_COMM_WORLD);
+
+		// Each vertex was placed by one group of ranks, and is 0
+		// everywhere else
+		MPI_Reduce(me == 0 ? MPI_IN_PLACE : part.data(), part.data(), (int)n, MPI_UINT32_T, MPI_MAX, 0, MPI_COMM_WORLD);
+		if ( me != 0 ) return;
+	}
+	else
+#endif
+	partition(g, 0, nparts, imbalance, rng, part);
+
+	uint32_t i = 0;
+	std::vector<double> part_weight(nparts, 0);
+	for ( PartitionComponent& comp : compMap ) {
+		comp.rank = RankInfo(part[i] / rankcount.thread, part[i] % rankcount.thread);
+		part_weight[part[i]] += comp.weight;
+		i++;
+	}
+
+	if ( partOutput->getVerboseLevel() >= 1 ) {
+		uint64_t cut = 0;
+		for ( PartitionLink& link : linkMap ) {
+			const RankInfo& r0 = compMap[link.component[0]].rank;
+			const RankInfo& r1 = compMap[link.component[1]].rank;
+			if ( r0 != r1 ) cut++;
+		}
+		double total_weight = 0;
+		double max_weight = 0;
+		for ( double w : part_weight ) {
+			total_weight += w;
+			max_weight = std::max(max_weight, w);
+		}
+		double avg = total_weight / nparts;
+		partOutput->verbose(CALL_INFO, 1, 0, "Multilevel partition cut %" PRIu64 " of %zu links; heaviest part is %.1f%% above the average weight.\n",
+		                    cut, linkMap.size(), avg > 0 ? 100.0 * (max_weight - avg) / avg : 0.0);
+	}
+}
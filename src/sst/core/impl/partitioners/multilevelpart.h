@@ -0,0 +1,83 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef SST_CORE_IMPL_PARTITONERS_MULTILEVELPART_H
+#define SST_CORE_IMPL_PARTITONERS_MULTILEVELPART_H
+
+#include <sst/core/sstpart.h>
+#include <sst/core/elementinfo.h>
+
+namespace SST {
+
+class Output;
+
+namespace IMPL {
+namespace Partition {
+
+/**
+Partitions the component graph by multilevel recursive bisection, in the
+style of METIS, without needing an external library.  Each bisection
+coarsens the graph by heavy edge matching and bisects the coarsest graph
+by greedy graph growing.  It then projects the bisection back through
+the levels, refining it at each one with Fiduccia-Mattheyses passes that
+keep the move gains in buckets.
+
+The goal is to cut as little link weight as possible (by default every
+link weighs the same, so as few links as possible) while keeping the
+total component weight of each part within a few percent of the
+average.
+Components joined by no-cut links are collapsed into one vertex before
+the partitioner sees the graph, so they always end up together.
+*/
+class SSTMultilevelPartition : public SST::Partition::SSTPartitioner {
+
+public:
+    SST_ELI_REGISTER_PARTITIONER(
+        SSTMultilevelPartition,
+        "sst",
+        "multilevel",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Multilevel (coarsen / bisect / refine) partitioner that minimizes the number of cut links while balancing component weight across ranks and threads.")
+
+protected:
+    /** Number of ranks in the simulation */
+    RankInfo rankcount;
+    /** Output object to print partitioning information */
+    Output* partOutput;
+    /** Whether every MPI rank calls performPartition and shares the work */
+    bool distributed;
+
+public:
+    /**
+       Creates a new multilevel partition scheme.
+       \param rankCount Number of ranks and threads in the simulation
+       \param verbosity The level of information to output
+    */
+    SSTMultilevelPartition(RankInfo rankCount, RankInfo my_rank, int verbosity);
+    ~SSTMultilevelPartition();
+
+    /**
+       Performs a partition of an SST simulation configuration
+       \param graph The simulation configuration to partition
+    */
+    void performPartition(PartitionGraph* graph) override;
+
+    bool requiresConfigGraph() override { return false; }
+    bool spawnOnAllRanks() override { return false; }
+
+};
+
+}
+}
+}
+
+#endif
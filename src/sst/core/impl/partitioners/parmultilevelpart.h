@@ -0,0 +1,61 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef SST_CORE_IMPL_PARTITONERS_PARMULTILEVELPART_H
+#define SST_CORE_IMPL_PARTITONERS_PARMULTILEVELPART_H
+
+#include <sst/core/impl/partitioners/multilevelpart.h>
+
+namespace SST {
+namespace IMPL {
+namespace Partition {
+
+/**
+The multilevel partitioner run on every MPI rank at once.  Rank 0 builds
+the adjacency lists of the partition graph and broadcasts them.  Every
+rank then bisects the whole graph with its own random choices, and the
+best bisection is kept.  The ranks split into two groups in proportion
+to the parts on each side, and each group goes on with its own side.
+Below the first level each rank coarsens and refines only its own slice
+of the graph, so the serial work per rank drops from
+O(graph * log(parts)) to about O(2 * graph).  The part numbers are
+combined on rank 0 at the end.
+
+Without MPI, or with a single process (including --shm-ranks, where the
+other ranks start after partitioning), this is the same as sst.multilevel.
+*/
+class SSTParallelMultilevelPartition : public SSTMultilevelPartition {
+
+public:
+    SST_ELI_REGISTER_PARTITIONER(
+        SSTParallelMultilevelPartition,
+        "sst",
+        "parmultilevel",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Multilevel partitioner that runs on every MPI rank, with each rank refining its own slice of the recursive bisection.")
+
+    /**
+       Creates a new distributed multilevel partition scheme.
+       \param rankCount Number of ranks and threads in the simulation
+       \param verbosity The level of information to output
+    */
+    SSTParallelMultilevelPartition(RankInfo rankCount, RankInfo my_rank, int verbosity);
+
+    bool spawnOnAllRanks() override { return true; }
+
+};
+
+}
+}
+}
+
+#endif
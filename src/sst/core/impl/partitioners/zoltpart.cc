@@ -188,6 +188,12 @@ SSTZoltanPartition::SSTZoltanPartition(RankInfo world_size, RankInfo my_rank, in
 void SSTZoltanPartition::initZoltan() {
 	partOutput->verbose(CALL_INFO, 2, 0, "Launching Zoltan initialization...\n");
 
+	int mpi_initialized = 0;
+	MPI_Initialized(&mpi_initialized);
+	if ( !mpi_initialized ) {
+		partOutput->fatal(CALL_INFO, -1, "The Zoltan partitioner needs MPI, which is not used with --shm-ranks\n");
+	}
+
 	float zolt_ver = 0;
 	int argc = 1;
 	char* argv[1];
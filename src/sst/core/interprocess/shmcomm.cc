@@ -0,0 +1,235 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/interprocess/shmcomm.h>
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace SST {
+namespace Core {
+namespace Interprocess {
+
+ShmComm* ShmComm::instance = NULL;
+
+ShmComm*
+ShmComm::init(uint32_t num_ranks, size_t ring_size)
+{
+    if ( instance == NULL ) {
+        instance = new ShmComm(num_ranks, ring_size);
+    }
+    return instance;
+}
+
+ShmComm::ShmComm(uint32_t num_ranks, size_t ring_size) :
+    rank(0), num_ranks(num_ranks), ring_size(ring_size), reduce_count(0),
+    shmPtr(NULL), shmSize(0), parent(getpid())
+{
+    ring_stride = (sizeof(RingHeader) + ring_size + 63) & ~((size_t)63);
+
+    size_t ctl_size = sizeof(Control) + (2 * num_ranks * sizeof(uint64_t));
+    ctl_size = (ctl_size + 63) & ~((size_t)63);
+    shmSize = ctl_size + (size_t)num_ranks * num_ranks * ring_stride;
+
+    // The name is only needed until the region is mapped.  Children
+    // inherit the mapping across fork(), so unlink it immediately.
+    char key[256];
+    std::string filename;
+    int fd;
+    do {
+        snprintf(key, sizeof(key), "/sst_shmcomm_%u-%d", getpid(), rand());
+        filename = key;
+        fd = shm_open(filename.c_str(), O_RDWR|O_CREAT|O_EXCL, S_IRUSR|S_IWUSR);
+    } while ( (fd < 0) && (errno == EEXIST) );
+    if ( fd < 0 ) {
+        // Not using Output because IPC means Output might not be available
+        fprintf(stderr, "Failed to create IPC region '%s': %s\n", filename.c_str(), strerror(errno));
+        exit(1);
+    }
+    shm_unlink(filename.c_str());
+
+    if ( ftruncate(fd, shmSize) ) {
+        fprintf(stderr, "Resizing shared file '%s' failed: %s\n", filename.c_str(), strerror(errno));
+        exit(1);
+    }
+
+    shmPtr = mmap(NULL, shmSize, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+    if ( shmPtr == MAP_FAILED ) {
+        fprintf(stderr, "mmap failed: %s\n", strerror(errno));
+        exit(1);
+    }
+    close(fd);
+
+    // ftruncate() zero fills, so the rings start out empty and only
+    // the pages for pairs of ranks that actually communicate get touched
+    ctl = static_cast<Control*>(shmPtr);
+    slots = reinterpret_cast<uint64_t*>(static_cast<char*>(shmPtr) + sizeof(Control));
+    rings = static_cast<char*>(shmPtr) + ctl_size;
+}
+
+uint32_t
+ShmComm::spawn()
+{
+    fflush(NULL);
+    for ( uint32_t r = 1; r < num_ranks; r++ ) {
+        pid_t pid = fork();
+        if ( pid < 0 ) {
+            fprintf(stderr, "Failed to fork rank %" PRIu32 ": %s\n", r, strerror(errno));
+            abort(1);
+        }
+        if ( pid == 0 ) {
+            rank = r;
+            children.clear();
+            return rank;
+        }
+        children.push_back(pid);
+    }
+    return rank;
+}
+
+int
+ShmComm::finish(int exit_code)
+{
+    if ( rank != 0 ) {
+        exitNow(exit_code);
+    }
+
+    int ret = exit_code;
+    for ( pid_t pid : children ) {
+        int status;
+        while ( waitpid(pid, &status, 0) < 0 && errno == EINTR );
+        if ( !WIFEXITED(status) || WEXITSTATUS(status) != 0 ) ret = 1;
+    }
+    children.clear();
+    return ret;
+}
+
+void
+ShmComm::abort(int exit_code)
+{
+    if ( __sync_bool_compare_and_swap(&ctl->aborted, 0, 1) ) {
+        ctl->abort_code = exit_code;
+        __sync_synchronize();
+    }
+    for ( pid_t pid : children ) {
+        kill(pid, SIGTERM);
+    }
+    exitNow(exit_code);
+}
+
+void
+ShmComm::exitNow(int exit_code)
+{
+    // Forked ranks share the launching process' atexit() handlers and
+    // library state, so leave without running them
+    fflush(NULL);
+    _exit(exit_code);
+}
+
+void
+ShmComm::checkPeers()
+{
+    if ( ctl->aborted ) {
+        exitNow(ctl->abort_code);
+    }
+    if ( rank == 0 ) {
+        for ( pid_t pid : children ) {
+            int status;
+            if ( waitpid(pid, &status, WNOHANG) == pid ) {
+                fprintf(stderr, "SST rank process %d exited unexpectedly, terminating\n", (int)pid);
+                abort(1);
+            }
+        }
+    }
+    else if ( getppid() != parent ) {
+        exitNow(1);
+    }
+}
+
+void
+ShmComm::pause(int loop_count)
+{
+    if ( (loop_count & 1023) == 1023 ) checkPeers();
+    pauser.processorPause(loop_count);
+}
+
+void
+ShmComm::barrier()
+{
+    uint32_t gen = __atomic_load_n(&ctl->generation, __ATOMIC_ACQUIRE);
+    if ( __atomic_add_fetch(&ctl->arrived, 1, __ATOMIC_ACQ_REL) == num_ranks ) {
+        __atomic_store_n(&ctl->arrived, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&ctl->generation, gen + 1, __ATOMIC_RELEASE);
+        return;
+    }
+
+    int loop_count = 0;
+    while ( __atomic_load_n(&ctl->generation, __ATOMIC_ACQUIRE) == gen ) {
+        pause(loop_count++);
+    }
+}
+
+size_t
+ShmComm::write(uint32_t dest, const char* buf, size_t len)
+{
+    RingHeader* ring = getRing(rank, dest);
+    char* data = reinterpret_cast<char*>(ring + 1);
+
+    uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    uint64_t tail = ring->tail;
+    size_t space = ring_size - (size_t)(tail - head);
+    if ( len > space ) len = space;
+    if ( len == 0 ) return 0;
+
+    size_t start = tail % ring_size;
+    size_t first = ring_size - start;
+    if ( first > len ) first = len;
+    ::memcpy(data + start, buf, first);
+    ::memcpy(data, buf + first, len - first);
+
+    __atomic_store_n(&ring->tail, tail + len, __ATOMIC_RELEASE);
+    return len;
+}
+
+size_t
+ShmComm::read(uint32_t src, char* buf, size_t len)
+{
+    RingHeader* ring = getRing(src, rank);
+    const char* data = reinterpret_cast<const char*>(ring + 1);
+
+    uint64_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    uint64_t head = ring->head;
+    size_t avail = (size_t)(tail - head);
+    if ( len > avail ) len = avail;
+    if ( len == 0 ) return 0;
+
+    size_t start = head % ring_size;
+    size_t first = ring_size - start;
+    if ( first > len ) first = len;
+    ::memcpy(buf, data + start, first);
+    ::memcpy(buf + first, data, len - first);
+
+    __atomic_store_n(&ring->head, head + len, __ATOMIC_RELEASE);
+    return len;
+}
+
+}
+}
+}
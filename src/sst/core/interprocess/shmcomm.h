@@ -0,0 +1,169 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_INTERPROCESS_SHMCOMM_H
+#define SST_CORE_INTERPROCESS_SHMCOMM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#include <sst/core/interprocess/sstmutex.h>
+
+namespace SST {
+namespace Core {
+namespace Interprocess {
+
+/**
+ * Communicator for ranks that run as processes on a single node.
+ *
+ * The segment is created by the launching process before it forks
+ * the other ranks, so every rank inherits the same mapping.  It holds
+ * one single-producer/single-consumer byte ring per ordered pair of
+ * ranks plus the state needed for barriers and small reductions.  No
+ * MPI calls are made by any rank once the ranks have been spawned.
+ */
+class ShmComm {
+
+public:
+    enum Op { SUM, MIN, MAX };
+
+    /**
+     * Create the shared segment for num_ranks ranks.  Must be called
+     * exactly once, before spawn().
+     * @param ring_size Bytes of buffering in each direction between two ranks
+     */
+    static ShmComm* init(uint32_t num_ranks, size_t ring_size = DEFAULT_RING_SIZE);
+
+    /** Returns the communicator, or NULL when not running in shared-memory mode */
+    static ShmComm* get() { return instance; }
+    static bool active() { return instance != NULL; }
+
+    /**
+     * Fork the remaining ranks.
+     * @return The rank of the calling process (0 in the original process)
+     */
+    uint32_t spawn();
+
+    /**
+     * Called at the end of a run.  Rank 0 waits for all of the other
+     * ranks to exit; every other rank exits with the given code and
+     * does not return.
+     * @return Non-zero if any rank failed
+     */
+    int finish(int exit_code);
+
+    /** Terminate all ranks.  Does not return. */
+    void abort(int exit_code);
+
+    uint32_t getRank() const { return rank; }
+    uint32_t getNumRanks() const { return num_ranks; }
+
+    void barrier();
+
+    template<typename T>
+    T allreduce(T value, Op op) {
+        static_assert(sizeof(T) <= sizeof(uint64_t), "allreduce is only supported for types of 64 bits or less");
+        // Alternate between two slot arrays so a single barrier is
+        // enough to protect the values until every rank has read them
+        uint64_t* vals = getSlots(reduce_count++ & 1);
+        uint64_t raw = 0;
+        ::memcpy(&raw, &value, sizeof(T));
+        __atomic_store_n(&vals[rank], raw, __ATOMIC_RELAXED);
+
+        barrier();
+
+        T result = value;
+        for ( uint32_t i = 0; i < num_ranks; i++ ) {
+            T v;
+            raw = __atomic_load_n(&vals[i], __ATOMIC_RELAXED);
+            ::memcpy(&v, &raw, sizeof(T));
+            if ( i == 0 ) { result = v; continue; }
+            switch ( op ) {
+            case SUM: result += v; break;
+            case MIN: if ( v < result ) result = v; break;
+            case MAX: if ( result < v ) result = v; break;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Non-blocking write into the ring to dest.
+     * @return Number of bytes accepted, possibly 0
+     */
+    size_t write(uint32_t dest, const char* buf, size_t len);
+
+    /**
+     * Non-blocking read from the ring from src.
+     * @return Number of bytes received, possibly 0
+     */
+    size_t read(uint32_t src, char* buf, size_t len);
+
+    /**
+     * Back off while waiting on other ranks.  Also notices if another
+     * rank has aborted or died, in which case this rank exits.
+     */
+    void pause(int loop_count);
+
+    static const size_t DEFAULT_RING_SIZE = 256 * 1024;
+
+private:
+    ShmComm(uint32_t num_ranks, size_t ring_size);
+
+    struct Control {
+        volatile uint32_t arrived;
+        volatile uint32_t generation;
+        volatile int32_t abort_code;
+        volatile uint32_t aborted;
+    };
+
+    struct RingHeader {
+        volatile uint64_t head;   // Bytes consumed, written by the reader
+        char pad0[64 - sizeof(uint64_t)];
+        volatile uint64_t tail;   // Bytes produced, written by the writer
+        char pad1[64 - sizeof(uint64_t)];
+    };
+
+    uint64_t* getSlots(int index) { return slots + (index * num_ranks); }
+    RingHeader* getRing(uint32_t src, uint32_t dst) {
+        return reinterpret_cast<RingHeader*>(rings + ((size_t)src * num_ranks + dst) * ring_stride);
+    }
+    void checkPeers();
+    void exitNow(int exit_code);
+
+    static ShmComm* instance;
+
+    uint32_t rank;
+    uint32_t num_ranks;
+    size_t ring_size;
+    size_t ring_stride;
+    uint64_t reduce_count;
+
+    void* shmPtr;
+    size_t shmSize;
+    Control* ctl;
+    uint64_t* slots;
+    char* rings;
+
+    pid_t parent;
+    std::vector<pid_t> children;
+    SSTMutex pauser;
+};
+
+}
+}
+}
+
+#endif
@@ -13,6 +13,7 @@
 #include "sst_config.h"
 
 #include "sst/core/iouse.h"
+#include "sst/core/interprocess/shmcomm.h"
 
 #include <sys/resource.h>
 #include <sst/core/warnmacros.h>
@@ -20,6 +21,15 @@
 DISABLE_WARN_MISSING_OVERRIDE
 #include <mpi.h>
 REENABLE_WARNING
+
+// Ranks made with --shm-ranks run without MPI, and before they are
+// spawned there is nothing to combine
+static bool mpiInitialized()
+{
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    return initialized;
+}
 #endif
 
 
@@ -32,8 +42,13 @@ uint64_t SST::Core::maxInputOperations() {
     uint64_t local_max_io_in = sim_ruse.ru_inblock;
     uint64_t global_max_io_in = local_max_io_in;
 
+    if ( Interprocess::ShmComm::active() ) {
+        global_max_io_in = Interprocess::ShmComm::get()->allreduce(local_max_io_in, Interprocess::ShmComm::MAX);
+    }
 #ifdef SST_CONFIG_HAVE_MPI
-    MPI_Allreduce(&local_max_io_in, &global_max_io_in, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
+    else if ( mpiInitialized() ) {
+        MPI_Allreduce(&local_max_io_in, &global_max_io_in, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
+    }
 #endif
 
     return global_max_io_in;
@@ -46,8 +61,13 @@ uint64_t SST::Core::maxOutputOperations() {
     uint64_t local_max_io_out = sim_ruse.ru_oublock;
     uint64_t global_max_io_out = local_max_io_out;
 
+    if ( Interprocess::ShmComm::active() ) {
+        global_max_io_out = Interprocess::ShmComm::get()->allreduce(local_max_io_out, Interprocess::ShmComm::MAX);
+    }
 #ifdef SST_CONFIG_HAVE_MPI
-    MPI_Allreduce(&local_max_io_out, &global_max_io_out, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
+    else if ( mpiInitialized() ) {
+        MPI_Allreduce(&local_max_io_out, &global_max_io_out, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
+    }
 #endif
 
     return global_max_io_out;
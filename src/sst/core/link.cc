@@ -37,6 +37,7 @@ Link::Link(LinkId_t id) :
     rFunctor( NULL ),
     defaultTimeBase( NULL ),
     latency(1),
+    gate( NULL ),
     type(HANDLER),
     id(id)
 {
@@ -49,6 +50,7 @@ Link::Link() :
     rFunctor( NULL ),
     defaultTimeBase( NULL ),
     latency(1),
+    gate( NULL ),
     type(HANDLER),
     id(-1)
 {
@@ -15,6 +15,7 @@
 #include <sst/core/sst_types.h>
 
 #include <sst/core/event.h>
+#include <sst/core/clockGate.h>
 // #include <sst/core/eventFunctor.h>
 
 namespace SST { 
@@ -28,6 +29,10 @@ class ActivityQueue;
 class SyncBase;
 
 class UnitAlgebra;
+
+namespace Core {
+class ComponentProfile;
+}
  
   /** Link between two components. Carries events */
 class Link {
@@ -42,6 +47,8 @@ public:
     friend class ThreadSync;
     friend class SyncManager;
     friend class ComponentInfo;
+    friend class Core::ComponentProfile;
+    friend class LinkMap;
     
     /** Create a new link with a given ID */
     Link(LinkId_t id);
@@ -110,8 +117,10 @@ public:
     /** Return the default Time Base for this link */
     TimeConverter* getDefaultTimeBase();
 
-    /** Causes an event to be delivered to the registered callback */
+    /** Causes an event to be delivered to the registered callback.
+     * Any clocks the receiver has idled are woken first. */
     inline void deliverEvent(Event* event) const {
+        if ( gate != NULL ) gate->wake();
         (*rFunctor)(event);
     }
 
@@ -182,6 +191,11 @@ protected:
     /** Pointer to the opposite side of this link */
     Link* pair_link;
 
+    /** Idle clocks of the receiving component, which an arriving event
+      wakes.  NULL unless the component has idled a clock.
+    */
+    Core::ClockGate* gate;
+
 private:
     Link( const Link& l );
 
@@ -19,6 +19,7 @@
 
 #include <sst/core/component.h>
 #include <sst/core/link.h>
+#include <sst/core/clockGate.h>
 
 namespace SST {
 
@@ -31,6 +32,8 @@ private:
     std::map<std::string,Link*> linkMap;
     const std::vector<std::string> * allowedPorts;
     std::vector<std::string> selfPorts;
+    /** Idle clocks woken by events on these links, NULL if none */
+    Core::ClockGate* clockGate;
 
     // bool checkPort(const char *def, const char *offered) const
     // {
@@ -119,13 +122,14 @@ private:
     // }
 
 public:
-    LinkMap() : allowedPorts(NULL) {}
+    LinkMap() : allowedPorts(NULL), clockGate(NULL) {}
     ~LinkMap() {
         // Delete all the links in the map
         for ( std::map<std::string,Link*>::iterator it = linkMap.begin(); it != linkMap.end(); ++it ) {
             delete it->second;
         }
         linkMap.clear();
+        delete clockGate;
     }
 
     /**
@@ -159,6 +163,25 @@ public:
     /** Inserts a new pair of name and link into the map */
     void insertLink(std::string name, Link* link) {
         linkMap.insert(std::pair<std::string,Link*>(name,link));
+        link->gate = clockGate;
+    }
+
+    /** Returns the gate holding the clocks idled by the owner of these
+     * links, or NULL if none has been idled */
+    Core::ClockGate* getClockGate() const {
+        return clockGate;
+    }
+
+    /** Returns the clock gate, creating it and attaching it to every
+     * link in the map if needed */
+    Core::ClockGate* createClockGate() {
+        if ( clockGate == NULL ) {
+            clockGate = new Core::ClockGate();
+            for ( std::map<std::string,Link*>::iterator it = linkMap.begin(); it != linkMap.end(); ++it ) {
+                it->second->gate = clockGate;
+            }
+        }
+        return clockGate;
     }
 
     /** Returns a Link pointer for a given name */
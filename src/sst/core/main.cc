@@ -24,12 +24,15 @@ REENABLE_WARNING
 #include <iostream>
 #include <fstream>
 #include <cinttypes>
+#include <cstdlib>
+#include <cstring>
 #include <signal.h>
 #include <time.h>
 
 #include <sst/core/activity.h>
 #include <sst/core/config.h>
 #include <sst/core/configGraph.h>
+#include <sst/core/configGraphBinary.h>
 #include <sst/core/factory.h>
 #include <sst/core/rankInfo.h>
 #include <sst/core/threadsafe.h>
@@ -43,12 +46,17 @@ REENABLE_WARNING
 
 #include <sst/core/model/sstmodel.h>
 #include <sst/core/model/pymodel.h>
+#include <sst/core/model/sdlmodel.h>
 #include <sst/core/memuse.h>
+#include <sst/core/startupProfiler.h>
+#include <sst/core/componentProfile.h>
+#include <sst/core/partitionReport.h>
 #include <sst/core/iouse.h>
 
 #include <sys/resource.h>
 
 #include <sst/core/objectComms.h>
+#include <sst/core/interprocess/shmcomm.h>
 
 // Configuration Graph Generation Options
 #include <sst/core/configGraphOutput.h>
@@ -63,6 +71,7 @@ using namespace SST::Core;
 using namespace SST::Partition;
 using namespace std;
 using namespace SST;
+using SST::Core::Interprocess::ShmComm;
 
 
 
@@ -150,6 +159,67 @@ static void dump_partition(Config& cfg, ConfigGraph* graph, const RankInfo &size
     }
 }
 
+// Second level of a hierarchical partition: split the components the
+// rank level put on rank across that rank's threads
+static void partition_threads(Config& cfg, Factory* factory, ConfigGraph* graph, const RankInfo& world_size, uint32_t rank,
+                              const ConfigGraph::RankIndex& index)
+{
+    SSTPartitioner* partitioner = factory->CreatePartitioner(cfg.thread_partitioner, RankInfo(1, world_size.thread), RankInfo(0, 0), cfg.verbose);
+    if ( partitioner->requiresConfigGraph() || partitioner->spawnOnAllRanks() ) {
+        g_output.fatal(CALL_INFO, 1, "ERROR: Partitioner %s can't be used as a thread partitioner; it must work on one rank's partition graph.\n",
+                cfg.thread_partitioner.c_str());
+    }
+
+    PartitionGraph* pgraph = graph->getCollapsedPartitionGraph(rank, index);
+    partitioner->performPartition(pgraph);
+
+    // The partitioner saw a single rank, so put the real one back
+    PartitionComponentMap_t& pcomps = pgraph->getComponentMap();
+    for ( PartitionComponentMap_t::iterator it = pcomps.begin(); it != pcomps.end(); ++it ) {
+        it->rank.rank = rank;
+    }
+    graph->annotateRanks(pgraph);
+
+    delete pgraph;
+    delete partitioner;
+}
+
+#ifdef SST_CONFIG_HAVE_MPI
+// After each rank has split its own components across threads, tell
+// the other ranks which thread their copies of our boundary components
+// ended up on, so cross-rank links are wired to the right thread
+static void share_boundary_threads(ConfigGraph* graph, uint32_t rank)
+{
+    ConfigComponentMap_t& comps = graph->getComponentMap();
+    ConfigLinkMap_t& links = graph->getLinkMap();
+
+    // Pairs of (component id, thread)
+    std::vector<uint64_t> mine;
+    for ( ConfigComponentMap_t::iterator it = comps.begin(); it != comps.end(); ++it ) {
+        if ( it->rank.rank != rank ) continue;
+        for ( LinkId_t id : it->allLinks() ) {
+            const ConfigLink& link = links[id];
+            if ( comps[COMPONENT_ID_MASK(link.component[0])].rank.rank != rank ||
+                 comps[COMPONENT_ID_MASK(link.component[1])].rank.rank != rank ) {
+                mine.push_back(it->id);
+                mine.push_back(it->rank.thread);
+                break;
+            }
+        }
+    }
+
+    std::vector<std::vector<uint64_t> > all;
+    Comms::all_gather(mine, all);
+    for ( uint32_t r = 0; r < all.size(); r++ ) {
+        if ( r == rank ) continue;
+        for ( size_t i = 0; i < all[r].size(); i += 2 ) {
+            if ( !graph->containsComponent(all[r][i]) ) continue;
+            graph->findComponent(all[r][i])->setRank(RankInfo(r, all[r][i+1]));
+        }
+    }
+}
+#endif
+
 static void do_graph_wireup(ConfigGraph* graph,
         SST::Simulation* sim,
         const RankInfo &myRank, SimTime_t min_part) {
@@ -216,9 +286,24 @@ void finalize_statEngineConfig(void)
     StatisticProcessingEngine::getInstance()->finalizeInitialization();
 }
 
+static void release_graph(SimThreadInfo_t &info)
+{
+    const uint64_t pre_release_rss = localMemSize();
+    delete info.graph;
+    info.graph = NULL;
+    releaseFreeMemory();
+    const uint64_t post_release_rss = localMemSize();
+
+    g_output.verbose(CALL_INFO, 1, 0, "# Released config graph on rank %" PRIu32 ": resident memory %" PRIu64 " KB -> %" PRIu64 " KB (%" PRIu64 " KB freed)\n",
+                     info.myRank.rank, pre_release_rss, post_release_rss,
+                     pre_release_rss > post_release_rss ? pre_release_rss - post_release_rss : 0);
+}
+
 static void start_simulation(uint32_t tid, SimThreadInfo_t &info, Core::ThreadSafe::Barrier &barrier)
 {
     info.myRank.thread = tid;
+    StartupProfiler::setThread(tid);
+    ComponentProfile::setThread(tid);
     double start_build = sst_get_cpu_time();
 
     if ( tid ) {
@@ -227,11 +312,15 @@ static void start_simulation(uint32_t tid, SimThreadInfo_t &info, Core::ThreadSa
     }
 
     ////// Create Simulation Objects //////
+    StartupProfiler::Phase create_phase("create_simulation");
     SST::Simulation* sim = Simulation::createSimulation(info.config, info.myRank, info.world_size, info.min_part);
+    create_phase.end();
 
     barrier.wait();
 
+    StartupProfiler::Phase graph_info_phase("process_graph_info");
     sim->processGraphInfo( *info.graph, info.myRank, info.min_part );
+    graph_info_phase.end();
 
     barrier.wait();
 
@@ -241,24 +330,33 @@ static void start_simulation(uint32_t tid, SimThreadInfo_t &info, Core::ThreadSa
     for ( uint32_t i = 0; i < info.world_size.thread; ++i ) {
         if ( i == info.myRank.thread ) {
             // g_output.output("wiring up this thread %u\n", info.myRank.thread);
+            StartupProfiler::Phase wireup_phase("wireup");
             do_graph_wireup(info.graph, sim, info.myRank, info.min_part);
         }
         barrier.wait();
     }
 
+    // Every thread is wired up and the statistics are configured, so
+    // nothing reads the graph again
     if ( tid == 0 ) {
+        StartupProfiler::Phase release_phase("release_graph");
         finalize_statEngineConfig();
-        delete info.graph;
+        release_graph(info);
     }
 
     double start_run = sst_get_cpu_time();
     info.build_time = start_run - start_build;
 
-#ifdef SST_CONFIG_HAVE_MPI
     if ( tid == 0 && info.world_size.rank > 1 ) {
-        MPI_Barrier(MPI_COMM_WORLD);
-    }
+        if ( ShmComm::active() ) {
+            ShmComm::get()->barrier();
+        }
+#ifdef SST_CONFIG_HAVE_MPI
+        else {
+            MPI_Barrier(MPI_COMM_WORLD);
+        }
 #endif
+    }
     barrier.wait();
 
     if ( info.config->runMode == Simulation::RUN || info.config->runMode == Simulation::BOTH ) {
@@ -286,7 +384,9 @@ static void start_simulation(uint32_t tid, SimThreadInfo_t &info, Core::ThreadSa
         // g_output.output("info.config.stopAtCycle = %s\n",info.config->stopAtCycle.c_str());
         sim->setStopAtCycle(info.config);
 
-        if ( tid == 0 && info.world_size.rank > 1 ) {
+        // Ranks spawned with --shm-ranks are forked after the graph is
+        // built, so they already have every library rank 0 loaded.
+        if ( tid == 0 && info.world_size.rank > 1 && !ShmComm::active() ) {
             // If we are a MPI_parallel job, need to makes sure that all used
             // libraries are loaded on all ranks.
 #ifdef SST_CONFIG_HAVE_MPI
@@ -313,16 +413,26 @@ static void start_simulation(uint32_t tid, SimThreadInfo_t &info, Core::ThreadSa
             }
 
             Comms::broadcast(lib_names, 0);
+            StartupProfiler::Phase library_phase("load_libraries");
             Factory::getFactory()->loadUnloadedLibraries(lib_names);
 #endif
         }
         barrier.wait();
 
+        StartupProfiler::Phase init_phase("initialize");
         sim->initialize();
+        init_phase.end();
         barrier.wait();
         
         /* Run Set */
+        StartupProfiler::Phase setup_phase("setup");
         sim->setup();
+        setup_phase.end();
+        barrier.wait();
+
+        // Components are done adding converted parameters to the
+        // shared caches, so the threads can read them without locking
+        if ( tid == 0 ) Params::freezeConverted();
         barrier.wait();
 
         /* Run Simulation */
@@ -351,16 +461,41 @@ static void start_simulation(uint32_t tid, SimThreadInfo_t &info, Core::ThreadSa
 
 }
 
+#ifdef SST_CONFIG_HAVE_MPI
+// Returns the value given to --shm-ranks (or an abbreviation of it, as
+// getopt allows), or 0.  This has to be known before MPI_Init.
+static long
+findShmRanks(int argc, char *argv[])
+{
+    static const char option[] = "--shm-ranks";
+    for ( int i = 1; i < argc; i++ ) {
+        const char* arg = argv[i];
+        if ( strcmp(arg, "--") == 0 ) break;
+        const char* value = strchr(arg, '=');
+        size_t len = value ? (size_t)(value - arg) : strlen(arg);
+        if ( len < 4 || len >= sizeof(option) || strncmp(arg, option, len) != 0 ) continue;
+        if ( value ) return strtol(value + 1, NULL, 10);
+        if ( i + 1 < argc ) return strtol(argv[i+1], NULL, 10);
+    }
+    return 0;
+}
+#endif
+
 int
 main(int argc, char *argv[])
 {
 #ifdef SST_CONFIG_HAVE_MPI
-    MPI_Init(&argc, &argv);
+    // Shared-memory ranks are made with fork(), which MPI does not
+    // support once it is initialized, so that mode runs without MPI
+    bool use_mpi = findShmRanks(argc, argv) <= 1;
 
     int myrank = 0;
-    int mysize = 0;
-    MPI_Comm_rank(MPI_COMM_WORLD, &myrank);
-    MPI_Comm_size(MPI_COMM_WORLD, &mysize);
+    int mysize = 1;
+    if ( use_mpi ) {
+        MPI_Init(&argc, &argv);
+        MPI_Comm_rank(MPI_COMM_WORLD, &myrank);
+        MPI_Comm_size(MPI_COMM_WORLD, &mysize);
+    }
 
     RankInfo world_size(mysize, 1);
     RankInfo myRank(myrank, 0);
@@ -378,20 +513,47 @@ main(int argc, char *argv[])
     }
     world_size.thread = cfg.getNumThreads();
 
+    if ( cfg.shm_ranks > 1 ) {
+        uint32_t launched_ranks = world_size.rank;
+#ifdef SST_CONFIG_HAVE_MPI
+        if ( use_mpi ) {
+            std::cerr << "--shm-ranks could not be found on the command line before MPI was started" << std::endl;
+            return -1;
+        }
+        // MPI is not started, so ask the launcher how many ranks it ran
+        for ( const char* var : { "OMPI_COMM_WORLD_SIZE", "PMI_SIZE" } ) {
+            const char* value = getenv(var);
+            if ( value != NULL && atoi(value) > 1 ) launched_ranks = atoi(value);
+        }
+#endif
+        if ( launched_ranks > 1 ) {
+            std::cerr << "--shm-ranks cannot be used when SST is launched with more than one MPI rank" << std::endl;
+            return -1;
+        }
+        world_size.rank = cfg.shm_ranks;
+        cfg.world_size.rank = cfg.shm_ranks;
+    }
+
+    if ( cfg.startup_profile_file != "" ) {
+        StartupProfiler::init(cfg.startup_profile_file, myRank, world_size);
+    }
+    if ( cfg.output_component_profile != "" ) {
+        ComponentProfile::init(cfg.output_component_profile, myRank, world_size);
+    }
+
     SSTModelDescription* modelGen = 0;
+    StartupProfiler::Phase model_phase("model_load");
 
-    if ( cfg.configFile != "NONE" ) {
+    if ( cfg.configFile != "NONE" && cfg.load_graph_binary == "" ) {
         string file_ext = "";
 
         if(cfg.configFile.size() > 3) {
             file_ext = cfg.configFile.substr(cfg.configFile.size() - 3);
 
             if(file_ext == "xml" || file_ext == "sdl") {
-                cfg.model_options = cfg.configFile;
-                cfg.configFile = SST_INSTALL_PREFIX "/libexec/xmlToPython.py";
-                file_ext = ".py";
+                modelGen = new SSTSDLModelDefinition(cfg.configFile, cfg.verbose, &cfg);
             }
-            if(file_ext == ".py") {
+            else if(file_ext == ".py") {
                 modelGen = new SSTPythonModelDefinition(cfg.configFile, cfg.verbose, &cfg);
             }
             else {
@@ -403,6 +565,7 @@ main(int argc, char *argv[])
         }
 
     }
+    model_phase.end();
 
     double start = sst_get_cpu_time();
 
@@ -414,6 +577,37 @@ main(int argc, char *argv[])
     
     g_output.verbose(CALL_INFO, 1, 0, "#main() My rank is (%u.%u), on %u/%u nodes/threads\n", myRank.rank,myRank.thread, world_size.rank, world_size.thread);
 
+    // A binary graph file replaces both graph construction and
+    // partitioning.  Every rank maps the file, but only reads the
+    // header here and its own section once the ranks are known.
+    ConfigGraphBinary* graphBinary = NULL;
+    if ( cfg.load_graph_binary != "" ) {
+        graphBinary = new ConfigGraphBinary(cfg.load_graph_binary);
+        if ( graphBinary->getWorldSize().rank != world_size.rank ||
+             graphBinary->getWorldSize().thread != world_size.thread ) {
+            g_output.fatal(CALL_INFO, 1, "Binary graph file %s was partitioned for %u ranks with %u threads each, but this run has %u ranks with %u threads each\n",
+                           cfg.load_graph_binary.c_str(), graphBinary->getWorldSize().rank, graphBinary->getWorldSize().thread,
+                           world_size.rank, world_size.thread);
+        }
+        if ( graphBinary->getTimeBase() != cfg.timeBase ) {
+            g_output.verbose(CALL_INFO, 1, 0, "# Using timebase %s from binary graph file\n", graphBinary->getTimeBase().c_str());
+            cfg.timeBase = graphBinary->getTimeBase();
+        }
+        // The file was written before each rank split its components
+        // across its threads, so that still has to happen here
+        if ( graphBinary->getThreadPartitioner() != "" && cfg.shm_ranks > 1 ) {
+            g_output.fatal(CALL_INFO, 1, "Binary graph file %s still has to be split across threads on each rank, which can't be done with --shm-ranks\n",
+                           cfg.load_graph_binary.c_str());
+        }
+        if ( graphBinary->getThreadPartitioner() != "" &&
+             ( cfg.thread_partitioner == "" || !cfg.partition_threads_on_ranks ) ) {
+            g_output.verbose(CALL_INFO, 1, 0, "# Using thread partitioner %s on each rank from binary graph file\n",
+                             graphBinary->getThreadPartitioner().c_str());
+            cfg.thread_partitioner = graphBinary->getThreadPartitioner();
+            cfg.partition_threads_on_ranks = true;
+        }
+    }
+
     // Get the memory before we create the graph
     const uint64_t pre_graph_create_rss = maxGlobalMemSize();
 
@@ -424,18 +618,21 @@ main(int argc, char *argv[])
     graph = new ConfigGraph();
 
     // Only rank 0 will populate the graph
-    if ( myRank.rank == 0 ) {
+    StartupProfiler::Phase construction_phase("graph_construction");
+    if ( myRank.rank == 0 && graphBinary == NULL ) {
         if ( cfg.generator != "NONE" ) {
             generateFunction func = factory->GetGenerator(cfg.generator);
+            graph->beginBulkLoad();
             func(graph,cfg.generator_options, world_size.rank);
         } else {
             graph = modelGen->createConfigGraph();
         }
     }
+    construction_phase.end();
     
 #ifdef SST_CONFIG_HAVE_MPI
     // Config is done - broadcast it
-    if ( world_size.rank > 1 ) {
+    if ( use_mpi && world_size.rank > 1 ) {
         Comms::broadcast(cfg, 0);
     }
 #endif
@@ -443,14 +640,18 @@ main(int argc, char *argv[])
     // Need to initialize TimeLord before we use UnitAlgebra
     Simulation::getTimeLord()->init(cfg.timeBase);
 
-    if ( myRank.rank == 0 ) {
-        graph->postCreationCleanup();
+    StartupProfiler::Phase cleanup_phase("graph_cleanup");
+    if ( myRank.rank == 0 && graphBinary == NULL ) {
+        // The other threads are not started yet, so their share of
+        // the machine is free to help with these passes
+        graph->postCreationCleanup(world_size.thread);
 
         // Check config graph to see if there are structural errors.
-        if ( graph->checkForStructuralErrors() ) {
+        if ( graph->checkForStructuralErrors(world_size.thread) ) {
             g_output.fatal(CALL_INFO, -1, "Structure errors found in the ConfigGraph.\n");
         }
     }
+    cleanup_phase.end();
 
     // Delete the model generator
     delete modelGen;
@@ -468,70 +669,110 @@ main(int argc, char *argv[])
 
 
     ////// Start Partitioning //////
-    double start_part = sst_get_cpu_time();
+    if ( graphBinary == NULL ) {
+        StartupProfiler::Phase partition_phase("partition");
+        double start_part = sst_get_cpu_time();
+
+        // With a thread partitioner, the main partitioner only splits
+        // the graph across ranks
+        bool hierarchical = cfg.thread_partitioner != "";
+        RankInfo part_size = hierarchical ? RankInfo(world_size.rank, 1) : world_size;
+
+        // Weights measured by an earlier run replace the ones set in
+        // the model
+        double events_per_link_weight = 0;
+        if ( myRank.rank == 0 && cfg.load_component_profile != "" ) {
+            events_per_link_weight = ComponentProfile::apply(cfg.load_component_profile, graph);
+        }
 
-    // If this is a serial job, just use the single partitioner,
-    // but the same code path
-    if ( world_size.rank == 1 && world_size.thread == 1) cfg.partitioner = "sst.single";
+        // If this is a serial job, just use the single partitioner,
+        // but the same code path
+        if ( part_size.rank == 1 && part_size.thread == 1) cfg.partitioner = "sst.single";
 
-    // Get the partitioner.  Built in partitioners are in the "sst" library.
-    SSTPartitioner* partitioner = factory->CreatePartitioner(cfg.partitioner, world_size, myRank, cfg.verbose);
+        // Get the partitioner.  Built in partitioners are in the "sst" library.
+        SSTPartitioner* partitioner = factory->CreatePartitioner(cfg.partitioner, part_size, myRank, cfg.verbose);
 
 
-    if ( partitioner->requiresConfigGraph() ) {
-        partitioner->performPartition(graph);
-    }
-    else {
-        PartitionGraph* pgraph;
-        if ( myRank.rank == 0 ) {
-            pgraph = graph->getCollapsedPartitionGraph();
+        if ( partitioner->requiresConfigGraph() ) {
+            partitioner->performPartition(graph);
         }
         else {
-            pgraph = new PartitionGraph();
-        }
-
-        if ( myRank.rank == 0 || partitioner->spawnOnAllRanks() ) {
-            partitioner->performPartition(pgraph);
-
-            if ( myRank.rank == 0 ) graph->annotateRanks(pgraph);
-        }
+            PartitionGraph* pgraph;
+            if ( myRank.rank == 0 ) {
+                pgraph = graph->getCollapsedPartitionGraph();
+            }
+            else {
+                pgraph = new PartitionGraph();
+            }
 
-        delete pgraph;
-    }
+            if ( myRank.rank == 0 || partitioner->spawnOnAllRanks() ) {
+                partitioner->performPartition(pgraph);
 
-    delete partitioner;
+                if ( myRank.rank == 0 ) graph->annotateRanks(pgraph);
+            }
 
-    // Check the partitioning to make sure it is sane
-    if ( myRank.rank == 0 ) {
-        if ( !graph->checkRanks( world_size ) ) {
-            g_output.fatal(CALL_INFO, 1,
-                    "ERROR: Bad partitioning; partition included unknown ranks.\n");
+            delete pgraph;
         }
-    }
-    double end_part = sst_get_cpu_time();
-    const uint64_t post_graph_create_rss = maxGlobalMemSize();
-
-    if(myRank.rank == 0) {
-        g_output.verbose(CALL_INFO, 1, 0, "# Graph partitioning took %lg seconds.\n", (end_part - start_part));
-        g_output.verbose(CALL_INFO, 1, 0, "# Graph construction and partition raised RSS by %" PRIu64 " KB\n",
-                (post_graph_create_rss - pre_graph_create_rss));
-        g_output.verbose(CALL_INFO, 1, 0, "# ------------------------------------------------------------\n");
 
+        delete partitioner;
+
+        // Shared-memory ranks all see rank 0's graph, so there is
+        // nothing to gain from splitting threads on each rank
+        bool threads_on_ranks = cfg.partition_threads_on_ranks && cfg.shm_ranks <= 1;
+        if ( hierarchical && world_size.thread > 1 && !threads_on_ranks && myRank.rank == 0 ) {
+            // Bucket the graph by rank once, rather than rescanning it
+            // for every rank
+            ConfigGraph::RankIndex index;
+            graph->indexRanks(world_size.rank, index);
+            for ( uint32_t r = 0; r < world_size.rank; r++ ) {
+                partition_threads(cfg, factory, graph, world_size, r, index);
+            }
+        }
 
-        // Output the partition information is user requests it
-        dump_partition(cfg, graph, world_size);
-        doGraphOutput(&cfg, graph);
+        // Check the partitioning to make sure it is sane
+        if ( myRank.rank == 0 ) {
+            if ( !graph->checkRanks( world_size ) ) {
+                g_output.fatal(CALL_INFO, 1,
+                        "ERROR: Bad partitioning; partition included unknown ranks.\n");
+            }
+        }
+        double end_part = sst_get_cpu_time();
+        partition_phase.end();
+        const uint64_t post_graph_create_rss = maxGlobalMemSize();
+
+        if(myRank.rank == 0) {
+            g_output.verbose(CALL_INFO, 1, 0, "# Graph partitioning took %lg seconds.\n", (end_part - start_part));
+            g_output.verbose(CALL_INFO, 1, 0, "# Graph construction and partition raised RSS by %" PRIu64 " KB\n",
+                    (post_graph_create_rss - pre_graph_create_rss));
+            g_output.verbose(CALL_INFO, 1, 0, "# ------------------------------------------------------------\n");
+
+
+            // Output the partition information is user requests it
+            StartupProfiler::Phase output_phase("graph_output");
+            dump_partition(cfg, graph, world_size);
+            doGraphOutput(&cfg, graph);
+
+            if ( cfg.partition_report_file != "" ) {
+                StartupProfiler::Phase report_phase("partition_report");
+                PartitionReport report(graph, world_size, !threads_on_ranks || !hierarchical, events_per_link_weight);
+                report.print(g_output);
+                report.write(cfg.partition_report_file);
+            }
+        }
     }
 
     ////// End Partitioning //////
 
     ////// Calculate Minimum Partitioning //////
     SimTime_t min_part = 0xffffffffffffffffl;
-    if ( world_size.rank > 1 ) {
+    if ( graphBinary != NULL ) {
+        min_part = graphBinary->getMinPartition();
+    }
+    else if ( world_size.rank > 1 ) {
         // Check the graph for the minimum latency crossing a partition boundary
         if ( myRank.rank == 0 ) {
-            ConfigComponentMap_t comps = graph->getComponentMap();
-            ConfigLinkMap_t links = graph->getLinkMap();
+            ConfigComponentMap_t& comps = graph->getComponentMap();
+            ConfigLinkMap_t& links = graph->getLinkMap();
             // Find the minimum latency across a partition
             for( ConfigLinkMap_t::iterator iter = links.begin();
                     iter != links.end(); ++iter ) {
@@ -557,11 +798,53 @@ main(int argc, char *argv[])
         //     min_part = Simulation::getTimeLord()->getSimCycles("1us","");
         // }
 
-        Comms::broadcast(min_part, 0);
+        if ( use_mpi ) Comms::broadcast(min_part, 0);
 #endif
     }
     ////// End Calculate Minimum Partitioning //////
 
+    // With --partition-threads-on-ranks the ranks split their
+    // components across threads only after the graph is distributed, so
+    // a graph file written before then records that this is still to do
+    bool split_threads_on_ranks = cfg.thread_partitioner != "" && cfg.partition_threads_on_ranks &&
+        cfg.shm_ranks <= 1 && world_size.thread > 1;
+    std::string pending_thread_partitioner = split_threads_on_ranks ? cfg.thread_partitioner : "";
+
+    if ( myRank.rank == 0 && graphBinary == NULL && cfg.output_graph_binary != "" ) {
+        StartupProfiler::Phase write_phase("write_graph_binary");
+        ConfigGraphBinary::write(cfg.output_graph_binary, graph, world_size, min_part, cfg.timeBase, pending_thread_partitioner);
+    }
+
+    ////// Spawn Shared-Memory Ranks //////
+    // Every rank gets a copy-on-write view of the partitioned graph,
+    // so there is nothing to distribute.
+    if ( cfg.shm_ranks > 1 ) {
+        ShmComm* shm = ShmComm::init(world_size.rank);
+        myRank.rank = shm->spawn();
+        myrank = myRank.rank;
+        Output::setWorldSize(world_size, myrank);
+        if ( StartupProfiler::get() ) StartupProfiler::get()->setRank(myRank.rank);
+        if ( ComponentProfile::get() ) ComponentProfile::get()->setRank(myRank.rank);
+        g_output.verbose(CALL_INFO, 1, 0, "#main() Spawned shared-memory rank (%u.%u) as pid %d\n", myRank.rank, myRank.thread, (int)getpid());
+    }
+    ////// End Spawn Shared-Memory Ranks //////
+
+    ////// Load Binary Graph //////
+    // Each rank reads its own section of the file, so there is no
+    // graph to distribute
+    if ( graphBinary != NULL ) {
+        StartupProfiler::Phase load_phase("load_graph_binary");
+        double start_load = sst_get_cpu_time();
+        delete graph;
+        graph = graphBinary->loadRank(myRank.rank);
+        delete graphBinary;
+        graphBinary = NULL;
+
+        g_output.verbose(CALL_INFO, 1, 0, "# Loading rank %u from binary graph file took %lg seconds.\n",
+                myRank.rank, sst_get_cpu_time() - start_load);
+    }
+    ////// End Load Binary Graph //////
+
     if(cfg.enable_sig_handling) {
         g_output.verbose(CALL_INFO, 1, 0, "Signal handlers will be registered for USR1, USR2, INT and TERM...\n");
         setupSignals(0);
@@ -572,7 +855,34 @@ main(int argc, char *argv[])
 
     ////// Broadcast Graph //////
 #ifdef SST_CONFIG_HAVE_MPI
-    if ( world_size.rank > 1 ) {
+    bool distribute_graph = world_size.rank > 1 && !ShmComm::active() && cfg.load_graph_binary == "";
+    StartupProfiler::Phase distribution_phase("graph_distribution");
+    double start_graph_dist = sst_get_cpu_time();
+    double graph_write_time = 0.0;
+    double graph_read_time = 0.0;
+
+    if ( distribute_graph && cfg.graph_distribution_file != "" ) {
+        // Rank 0 writes every rank's subgraph to a file once, then all
+        // ranks pull their own section out of it at the same time
+        if ( 0 == myRank.rank && cfg.graph_distribution_file != cfg.output_graph_binary ) {
+            ConfigGraphBinary::write(cfg.graph_distribution_file, graph, world_size, min_part, cfg.timeBase, pending_thread_partitioner);
+        }
+        graph_write_time = sst_get_cpu_time() - start_graph_dist;
+        MPI_Barrier(MPI_COMM_WORLD);
+
+        double start_read = sst_get_cpu_time();
+        ConfigGraphBinary* graphFile = new ConfigGraphBinary(cfg.graph_distribution_file);
+        delete graph;
+        graph = graphFile->loadRank(myRank.rank);
+        delete graphFile;
+        double local_read_time = sst_get_cpu_time() - start_read;
+        MPI_Allreduce(&local_read_time, &graph_read_time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+        if ( 0 == myRank.rank && cfg.graph_distribution_file != cfg.output_graph_binary ) {
+            unlink(cfg.graph_distribution_file.c_str());
+        }
+    }
+    else if ( distribute_graph ) {
         Comms::broadcast(Params::keyMap, 0);
         Comms::broadcast(Params::keyMapReverse, 0);
         Comms::broadcast(Params::nextKeyID, 0);
@@ -623,9 +933,39 @@ main(int argc, char *argv[])
             delete your_graph;
         }
     }
+
+    if ( distribute_graph ) {
+        // Wait for the slowest rank so the time covers the whole distribution
+        MPI_Barrier(MPI_COMM_WORLD);
+        if ( 0 == myRank.rank ) {
+            g_output.verbose(CALL_INFO, 1, 0, "# Graph distribution took %lg seconds.\n", sst_get_cpu_time() - start_graph_dist);
+            if ( cfg.graph_distribution_file != "" ) {
+                g_output.verbose(CALL_INFO, 1, 0, "#   Writing %s took %lg seconds, slowest rank read its subgraph in %lg seconds.\n",
+                        cfg.graph_distribution_file.c_str(), graph_write_time, graph_read_time);
+            }
+        }
+    }
+    distribution_phase.end();
 #endif
     ////// End Broadcast Graph //////
 
+    ////// Partition Threads //////
+    // Each rank splits its own components across its threads, in
+    // parallel with the other ranks
+    if ( split_threads_on_ranks ) {
+        StartupProfiler::Phase thread_part_phase("thread_partition");
+        double start_thread_part = sst_get_cpu_time();
+        ConfigGraph::RankIndex index;
+        graph->indexRanks(world_size.rank, index);
+        partition_threads(cfg, factory, graph, world_size, myRank.rank, index);
+#ifdef SST_CONFIG_HAVE_MPI
+        if ( world_size.rank > 1 ) share_boundary_threads(graph, myRank.rank);
+#endif
+        g_output.verbose(CALL_INFO, 1, 0, "# Thread partitioning on rank %u took %lg seconds.\n",
+                myRank.rank, sst_get_cpu_time() - start_thread_part);
+    }
+    ////// End Partition Threads //////
+
     // // Print the graph
     // if ( myRank.rank == 0 ) {
     //     std::cout << "Rank 0 graph:" << std::endl;
@@ -640,7 +980,9 @@ main(int argc, char *argv[])
 
     ///// Set up StatisticEngine /////
 
+    StartupProfiler::Phase stat_phase("stat_engine_init");
     SST::Statistics::StatisticProcessingEngine::init(graph);
+    stat_phase.end();
 
     ///// End Set up StatisticEngine /////
 
@@ -650,7 +992,12 @@ main(int argc, char *argv[])
 
     Simulation::factory = factory;
     Simulation::sim_output = g_output;
+    Simulation::syncCompressThreshold = cfg.sync_compress_threshold;
     Simulation::resizeBarriers(world_size.thread);
+
+    // The parameter key table is complete now, so let the simulation
+    // threads look keys up without taking its lock
+    Params::publishKeyMap();
     #ifdef USE_MEMPOOL
     /* Estimate that we won't have more than 128 sizes of events */
     Activity::memPools.reserve(world_size.thread * 128);
@@ -716,31 +1063,48 @@ main(int argc, char *argv[])
     Activity::getMemPoolUsage(mempool_size, active_activities);
 #endif
 
+    if ( ShmComm::active() ) {
+        ShmComm* shm = ShmComm::get();
+        uint64_t local_sync_data_size = threadInfo[0].sync_data_size;
+
+        max_run_time = shm->allreduce(run_time, ShmComm::MAX);
+        max_build_time = shm->allreduce(build_time, ShmComm::MAX);
+        max_total_time = shm->allreduce(total_time, ShmComm::MAX);
+        global_max_tv_depth = shm->allreduce(local_max_tv_depth, ShmComm::MAX);
+        global_current_tv_depth = shm->allreduce(local_current_tv_depth, ShmComm::SUM);
+        global_max_sync_data_size = shm->allreduce(local_sync_data_size, ShmComm::MAX);
+        global_sync_data_size = shm->allreduce(local_sync_data_size, ShmComm::SUM);
+        max_mempool_size = shm->allreduce(mempool_size, ShmComm::MAX);
+        global_mempool_size = shm->allreduce(mempool_size, ShmComm::SUM);
+        global_active_activities = shm->allreduce(active_activities, ShmComm::SUM);
+    }
+    else {
 #ifdef SST_CONFIG_HAVE_MPI
-    uint64_t local_sync_data_size = threadInfo[0].sync_data_size;
-
-    MPI_Allreduce(&run_time, &max_run_time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
-    MPI_Allreduce(&build_time, &max_build_time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
-    MPI_Allreduce(&total_time, &max_total_time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
-    MPI_Allreduce(&local_max_tv_depth, &global_max_tv_depth, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
-    MPI_Allreduce(&local_current_tv_depth, &global_current_tv_depth, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
-    MPI_Allreduce(&local_sync_data_size, &global_max_sync_data_size, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
-    MPI_Allreduce(&local_sync_data_size, &global_sync_data_size, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
-    MPI_Allreduce(&mempool_size, &max_mempool_size, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
-    MPI_Allreduce(&mempool_size, &global_mempool_size, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
-    MPI_Allreduce(&active_activities, &global_active_activities, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+        uint64_t local_sync_data_size = threadInfo[0].sync_data_size;
+
+        MPI_Allreduce(&run_time, &max_run_time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
+        MPI_Allreduce(&build_time, &max_build_time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
+        MPI_Allreduce(&total_time, &max_total_time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
+        MPI_Allreduce(&local_max_tv_depth, &global_max_tv_depth, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
+        MPI_Allreduce(&local_current_tv_depth, &global_current_tv_depth, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+        MPI_Allreduce(&local_sync_data_size, &global_max_sync_data_size, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
+        MPI_Allreduce(&local_sync_data_size, &global_sync_data_size, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+        MPI_Allreduce(&mempool_size, &max_mempool_size, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
+        MPI_Allreduce(&mempool_size, &global_mempool_size, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+        MPI_Allreduce(&active_activities, &global_active_activities, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
 #else
-    max_build_time = build_time;
-    max_run_time = run_time;
-    max_total_time = total_time;
-    global_max_tv_depth = local_max_tv_depth;
-    global_current_tv_depth = local_current_tv_depth;
-    global_max_sync_data_size = 0;
-    global_max_sync_data_size = 0;
-    max_mempool_size = mempool_size;
-    global_mempool_size = mempool_size;
-    global_active_activities = active_activities;
+        max_build_time = build_time;
+        max_run_time = run_time;
+        max_total_time = total_time;
+        global_max_tv_depth = local_max_tv_depth;
+        global_current_tv_depth = local_current_tv_depth;
+        global_max_sync_data_size = 0;
+        global_max_sync_data_size = 0;
+        max_mempool_size = mempool_size;
+        global_mempool_size = mempool_size;
+        global_active_activities = active_activities;
 #endif
+    }
 
     const uint64_t local_max_rss     = maxLocalMemSize();
     const uint64_t global_max_rss    = maxGlobalMemSize();
@@ -820,20 +1184,24 @@ main(int argc, char *argv[])
     }
 #endif
     
-#ifdef SST_CONFIG_HAVE_MPI
     if( 0 == myRank.rank ) {
-#endif
         // Print out the simulation time regardless of verbosity.
         g_output.output("Simulation is complete, simulated time: %s\n", threadInfo[0].simulated_time.toStringBestSI().c_str());
-#ifdef SST_CONFIG_HAVE_MPI
     }
-#endif
 
+    if ( StartupProfiler::get() ) StartupProfiler::get()->write();
+    if ( ComponentProfile::get() ) ComponentProfile::get()->write();
+
+    int exit_code = 0;
+    if ( ShmComm::active() ) {
+        // Only rank 0 returns; it waits for the other ranks to exit
+        exit_code = ShmComm::get()->finish(0);
+    }
 
 #ifdef SST_CONFIG_HAVE_MPI
-    MPI_Finalize();
+    if ( use_mpi ) MPI_Finalize();
 #endif
 
-    return 0;
+    return exit_code;
 }
 
@@ -13,13 +13,33 @@
 #include "sst_config.h"
 
 #include "sst/core/memuse.h"
+#include "sst/core/interprocess/shmcomm.h"
 #include <sst/core/warnmacros.h>
 #include <sys/resource.h>
+#include <unistd.h>
+#include <cstdio>
+
+#ifdef SST_COMPILE_MACOSX
+#include <mach/mach.h>
+#endif
+
+#if defined(HAVE_MALLOC_H) && defined(HAVE_MALLOC_TRIM)
+#include <malloc.h>
+#endif
 
 #ifdef SST_CONFIG_HAVE_MPI
 DISABLE_WARN_MISSING_OVERRIDE
 #include <mpi.h>
 REENABLE_WARNING
+
+// Ranks made with --shm-ranks run without MPI, and before they are
+// spawned there is nothing to combine
+static bool mpiInitialized()
+{
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    return initialized;
+}
 #endif
 
 
@@ -32,8 +52,13 @@ uint64_t SST::Core::maxLocalMemSize() {
 
     uint64_t local_max_rss = sim_ruse.ru_maxrss;
     uint64_t global_max_rss = local_max_rss;
+    if ( Interprocess::ShmComm::active() ) {
+        global_max_rss = Interprocess::ShmComm::get()->allreduce(local_max_rss, Interprocess::ShmComm::MAX);
+    }
 #ifdef SST_CONFIG_HAVE_MPI
-    MPI_Allreduce(&local_max_rss, &global_max_rss, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
+    else if ( mpiInitialized() ) {
+        MPI_Allreduce(&local_max_rss, &global_max_rss, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
+    }
 #endif
 
 #ifdef SST_COMPILE_MACOSX
@@ -50,8 +75,13 @@ uint64_t SST::Core::maxGlobalMemSize() {
 
     uint64_t local_max_rss = sim_ruse.ru_maxrss;
     uint64_t global_max_rss = local_max_rss;
+    if ( Interprocess::ShmComm::active() ) {
+        global_max_rss = Interprocess::ShmComm::get()->allreduce(local_max_rss, Interprocess::ShmComm::SUM);
+    }
 #ifdef SST_CONFIG_HAVE_MPI
-    MPI_Allreduce(&local_max_rss, &global_max_rss, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+    else if ( mpiInitialized() ) {
+        MPI_Allreduce(&local_max_rss, &global_max_rss, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+    }
 #endif
 
 #ifdef SST_COMPILE_MACOSX
@@ -68,8 +98,13 @@ uint64_t SST::Core::maxLocalPageFaults() {
     
     uint64_t local_pf = sim_ruse.ru_majflt;
     uint64_t global_max_pf = local_pf;
+    if ( Interprocess::ShmComm::active() ) {
+        global_max_pf = Interprocess::ShmComm::get()->allreduce(local_pf, Interprocess::ShmComm::MAX);
+    }
 #ifdef SST_CONFIG_HAVE_MPI
-    MPI_Allreduce(&local_pf, &global_max_pf, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
+    else if ( mpiInitialized() ) {
+        MPI_Allreduce(&local_pf, &global_max_pf, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD );
+    }
 #endif
 	return global_max_pf;
 };
@@ -80,9 +115,38 @@ uint64_t SST::Core::globalPageFaults() {
 
     uint64_t local_pf = sim_ruse.ru_majflt;
     uint64_t global_pf = local_pf;
+    if ( Interprocess::ShmComm::active() ) {
+        global_pf = Interprocess::ShmComm::get()->allreduce(local_pf, Interprocess::ShmComm::SUM);
+    }
 #ifdef SST_CONFIG_HAVE_MPI
-    MPI_Allreduce(&local_pf, &global_pf, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+    else if ( mpiInitialized() ) {
+        MPI_Allreduce(&local_pf, &global_pf, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD );
+    }
 #endif
 
 	return global_pf;
 };
+
+uint64_t SST::Core::localMemSize() {
+#ifdef SST_COMPILE_MACOSX
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if ( task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS ) return 0;
+    return info.resident_size / 1024;
+#else
+    // Second field of statm is the resident set in pages
+    FILE* fp = fopen("/proc/self/statm", "r");
+    if ( fp == NULL ) return 0;
+    unsigned long size = 0, resident = 0;
+    int found = fscanf(fp, "%lu %lu", &size, &resident);
+    fclose(fp);
+    if ( found != 2 ) return 0;
+    return (uint64_t)resident * (sysconf(_SC_PAGESIZE) / 1024);
+#endif
+}
+
+void SST::Core::releaseFreeMemory() {
+#if defined(HAVE_MALLOC_H) && defined(HAVE_MALLOC_TRIM)
+    malloc_trim(0);
+#endif
+}
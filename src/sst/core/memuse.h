@@ -23,6 +23,11 @@ uint64_t maxGlobalMemSize();
 uint64_t maxLocalPageFaults();
 uint64_t globalPageFaults();
 
+/** Current resident set size of this process in KB (0 if unknown) */
+uint64_t localMemSize();
+/** Return memory freed by the program to the operating system, where the allocator supports it */
+void releaseFreeMemory();
+
 }
 }
 
@@ -204,6 +204,125 @@ static PyObject* findComponentByName(PyObject* UNUSED(self), PyObject* args)
     return Py_None;
 }
 
+static PyObject* createComponents(PyObject* UNUSED(self), PyObject* args)
+{
+    char *prefix, *type;
+    unsigned long count;
+    PyObject *params = NULL;
+    if ( !PyArg_ParseTuple(args, "ssk|O!", &prefix, &type, &count, &PyDict_Type, &params) )
+        return NULL;
+    if ( count == 0 ) {
+        PyErr_SetString(PyExc_ValueError, "createComponents() needs a count of at least 1");
+        return NULL;
+    }
+
+    // Convert the parameters once and share them between the components
+    Params p;
+    if ( params != NULL ) {
+        Py_ssize_t pos = 0;
+        PyObject *key, *val;
+        bool bk = p.enableVerify(false);
+        while ( PyDict_Next(params, &pos, &key, &val) ) {
+            PyObject *kstr = PyObject_CallMethod(key, (char*)"__str__", NULL);
+            PyObject *vstr = PyObject_CallMethod(val, (char*)"__str__", NULL);
+            p.insert(PyString_AsString(kstr), PyString_AsString(vstr));
+            Py_XDECREF(kstr);
+            Py_XDECREF(vstr);
+        }
+        p.enableVerify(bk);
+        gModel->internParams(p);
+    }
+
+    char *fullPrefix = gModel->addNamePrefix(prefix);
+    ComponentId_t first = gModel->addComponents(fullPrefix, type, count);
+    free(fullPrefix);
+    gModel->getOutput()->verbose(CALL_INFO, 3, 0, "Created %lu components of type [%s]: ids [%" PRIu64 " - %" PRIu64 "]\n",
+            count, type, first, first + count - 1);
+
+    ConfigComponentMap_t &comps = gModel->getGraph()->getComponentMap();
+    PyObject *list = PyList_New(count);
+    for ( unsigned long i = 0; i < count; i++ ) {
+        ConfigComponent &c = comps[first + i];
+        if ( params != NULL ) {
+            bool bk = c.params.enableVerify(false);
+            c.params.insert(p);
+            c.params.enableVerify(bk);
+        }
+
+        PyObject *argList = Py_BuildValue("ssk", c.name.c_str(), type, c.id);
+        PyObject *res = PyObject_CallObject((PyObject *) &PyModel_ComponentType, argList);
+        Py_DECREF(argList);
+        if ( res == NULL ) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, res);
+    }
+    return list;
+}
+
+
+static bool getComponentId(PyObject *obj, ComponentId_t &id)
+{
+    if ( PyObject_TypeCheck(obj, &PyModel_ComponentType) || PyObject_TypeCheck(obj, &PyModel_SubComponentType) ) {
+        ConfigComponent *c = getComp(obj);
+        if ( c == NULL ) return false;
+        id = c->id;
+        return true;
+    }
+    if ( PyInt_Check(obj) || PyLong_Check(obj) ) {
+        id = PyLong_AsUnsignedLongLong(obj);
+        if ( PyErr_Occurred() ) return false;
+        if ( !gModel->getGraph()->containsComponent(COMPONENT_ID_MASK(id)) ) {
+            PyErr_Format(PyExc_ValueError, "No component with id %" PRIu64, id);
+            return false;
+        }
+        return true;
+    }
+    PyErr_SetString(PyExc_TypeError, "Expected an sst.Component, sst.SubComponent or component id");
+    return false;
+}
+
+
+static PyObject* connectLinks(PyObject* UNUSED(self), PyObject* arg)
+{
+    PyObject *seq = PySequence_Fast(arg, "connectLinks() expects a list of (compA, portA, compB, portB, latency[, name]) tuples");
+    if ( seq == NULL ) return NULL;
+
+    ConfigGraph *graph = gModel->getGraph();
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+    for ( Py_ssize_t i = 0; i < count; i++ ) {
+        PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+        PyObject *c0, *c1;
+        char *port0, *port1, *lat;
+        char *name = NULL;
+        ComponentId_t id0, id1;
+
+        if ( !PyArg_ParseTuple(item, "OsOss|s", &c0, &port0, &c1, &port1, &lat, &name) ||
+             !getComponentId(c0, id0) || !getComponentId(c1, id1) ) {
+            Py_DECREF(seq);
+            return NULL;
+        }
+
+        if ( name != NULL ) {
+            char *fullName = gModel->addNamePrefix(name);
+            gModel->connectLink(fullName, id0, port0, id1, port1, lat);
+            free(fullName);
+        }
+        else {
+            // Without a name, make one from the two endpoints
+            std::string linkName = graph->findComponent(id0)->name + ":" + std::string(port0) + "__" +
+                graph->findComponent(id1)->name + ":" + std::string(port1);
+            gModel->connectLink(linkName.c_str(), id0, port0, id1, port1, lat);
+        }
+    }
+    Py_DECREF(seq);
+
+    gModel->getOutput()->verbose(CALL_INFO, 3, 0, "Connected %ld links\n", (long)count);
+    return PyInt_FromLong(count);
+}
+
+
 static PyObject* setProgramOption(PyObject* UNUSED(self), PyObject* args)
 {
     char *param, *value;
@@ -298,8 +417,12 @@ static PyObject* exitsst(PyObject* UNUSED(self), PyObject* UNUSED(args))
 static PyObject* getSSTMPIWorldSize(PyObject* UNUSED(self), PyObject* UNUSED(args)) {
     int ranks = 1;
 #ifdef SST_CONFIG_HAVE_MPI
-    MPI_Comm_size(MPI_COMM_WORLD, &ranks);
+    int mpi_initialized = 0;
+    MPI_Initialized(&mpi_initialized);
+    if ( mpi_initialized ) MPI_Comm_size(MPI_COMM_WORLD, &ranks);
 #endif
+    Config *cfg = gModel->getConfig();
+    if ( cfg->shm_ranks > 1 ) ranks = cfg->shm_ranks;
     return PyInt_FromLong(ranks);
 }
 
@@ -584,6 +707,12 @@ static PyMethodDef sstModuleMethods[] = {
     {   "findComponentByName",
         findComponentByName, METH_O,
         "Looks up to find a previously created component, based off of its name.  Returns None if none are to be found."},
+    {   "createComponents",
+        createComponents, METH_VARARGS,
+        "Creates count components of one type named prefix0 .. prefix<count-1>, optionally all with the same parameters (form: createComponents(prefix, type, count, params)).  Returns a list of the new components."},
+    {   "connectLinks",
+        connectLinks, METH_O,
+        "Creates and connects a link for each (compA, portA, compB, portB, latency[, name]) tuple in a list.  Components may be given as objects or ids."},
     {   NULL, NULL, 0, NULL }
 };
 
@@ -600,6 +729,7 @@ void SSTPythonModelDefinition::initModel(const std::string script_file, int verb
     gModel = this;
 
     graph = new ConfigGraph();
+    graph->beginBulkLoad();
     nextComponentId = 0;
 
     std::string local_script_name;
@@ -55,6 +55,7 @@ class SSTPythonModelDefinition : public SSTModelDescription {
         std::vector<size_t> nameStack;
         std::map<std::string, ComponentId_t> compNameMap;
         ComponentId_t nextComponentId;
+        Params::SharedSetTable paramSets;
 
 
 	public:  /* Public, but private.  Called only from Python functions */
@@ -68,12 +69,29 @@ class SSTPythonModelDefinition : public SSTModelDescription {
             compNameMap[std::string(name)] = id;
             return id;
         }
+        /** Share the storage of p with any identical parameter set seen before */
+        void internParams(Params &p) { paramSets.intern(p); }
         ComponentId_t findComponentByName(const char *name) const {
             auto itr = compNameMap.find(name);
             return ( itr != compNameMap.end() ) ? itr->second : UNSET_COMPONENT_ID;
         }
 
+        /** Creates count components named prefix0 .. prefix<count-1>.  Returns the ID of the first one */
+        ComponentId_t addComponents(const std::string &prefix, const char *type, uint64_t count) {
+            ComponentId_t first = nextComponentId;
+            for ( uint64_t i = 0; i < count; i++ ) {
+                std::string name = prefix + std::to_string(i);
+                ComponentId_t id = getNextComponentId();
+                graph->addComponent(id, name, type);
+                compNameMap.insert(std::make_pair(name, id));
+            }
+            return first;
+        }
+
         void addLink(ComponentId_t id, const char *link_name, const char *port, const char *latency, bool no_cut) const {graph->addLink(id, link_name, port, latency, no_cut); }
+        void connectLink(const char *link_name, ComponentId_t id0, const char *port0, ComponentId_t id1, const char *port1, const char *latency) const {
+            graph->addLink(link_name, id0, port0, latency, id1, port1, latency);
+        }
         void setLinkNoCut(const char *link_name) const {graph->setLinkNoCut(link_name); }
 
         void pushNamePrefix(const char *name);
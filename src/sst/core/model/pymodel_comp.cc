@@ -119,7 +119,7 @@ static int compInit(ComponentPy_t *self, PyObject *args, PyObject *UNUSED(kwds))
         obj->id = gModel->addComponent(obj->name, type);
         gModel->getOutput()->verbose(CALL_INFO, 3, 0, "Creating component [%s] of type [%s]: id [%" PRIu64 "]\n", name, type, obj->id);
     } else {
-        obj->name = name;
+        obj->name = strdup(name);
         obj->id = useID;
     }
 
@@ -165,6 +165,7 @@ static PyObject* compAddParams(PyObject *self, PyObject *args)
     Py_ssize_t pos = 0;
     PyObject *key, *val;
     long count = 0;
+    bool was_empty = c->params.empty();
 
     while ( PyDict_Next(args, &pos, &key, &val) ) {
         PyObject *kstr = PyObject_CallMethod(key, (char*)"__str__", NULL);
@@ -174,6 +175,9 @@ static PyObject* compAddParams(PyObject *self, PyObject *args)
         Py_XDECREF(vstr);
         count++;
     }
+
+    // Components given the same dictionary share one copy of it
+    if ( was_empty ) gModel->internParams(c->params);
     return PyInt_FromLong(count);
 }
 
@@ -0,0 +1,392 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <sst/core/model/sdlmodel.h>
+
+#include <sst/core/tinyxml/tinyxml.h>
+
+#include <cctype>
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+using namespace SST;
+using namespace SST::Core;
+
+namespace {
+
+/**
+ * Splits an SDL file into markup and character data without building
+ * a document.  Comments, processing instructions and declarations are
+ * skipped.
+ */
+class SDLReader {
+public:
+    enum Token { START, END, EMPTY, TEXT, DONE };
+
+    SDLReader(std::istream& in) : buf(in.rdbuf()), line(1) {}
+
+    /** Line number of the start of the last token returned by next() */
+    int getLine() const { return token_line; }
+
+    /**
+     * Read the next tag or run of character data into text.  For tags,
+     * name is set to the element name.
+     */
+    Token next(std::string& text, std::string& name)
+    {
+        for (;;) {
+            text.clear();
+            name.clear();
+            token_line = line;
+
+            int c = buf->sgetc();
+            if ( c == EOF ) return DONE;
+
+            if ( c != '<' ) {
+                while ( (c = buf->sgetc()) != EOF && c != '<' ) {
+                    append(text, buf->sbumpc());
+                }
+                return TEXT;
+            }
+
+            append(text, buf->sbumpc());
+            c = buf->sgetc();
+            if ( c == '!' || c == '?' ) {
+                skipMarkup();
+                continue;
+            }
+
+            // Read to the closing '>', which may not appear inside a
+            // quoted attribute value
+            char quote = 0;
+            while ( (c = buf->sbumpc()) != EOF ) {
+                append(text, c);
+                if ( quote ) {
+                    if ( c == quote ) quote = 0;
+                }
+                else if ( c == '"' || c == '\'' ) quote = c;
+                else if ( c == '>' ) break;
+            }
+            if ( c == EOF ) return DONE;
+
+            size_t start = text[1] == '/' ? 2 : 1;
+            size_t end = start;
+            while ( end < text.size() && !isspace(text[end]) && text[end] != '/' && text[end] != '>' ) end++;
+            name = text.substr(start, end - start);
+
+            if ( start == 2 ) return END;
+            if ( text[text.size() - 2] == '/' ) return EMPTY;
+            return START;
+        }
+    }
+
+    /**
+     * Append the rest of the element whose start tag was just returned
+     * by next() to text.  Returns false if the file ends first.
+     */
+    bool readElement(std::string& text)
+    {
+        std::string token, name;
+        int depth = 1;
+        while ( depth > 0 ) {
+            switch ( next(token, name) ) {
+            case START: depth++; break;
+            case END: depth--; break;
+            case DONE: return false;
+            default: break;
+            }
+            text += token;
+        }
+        return true;
+    }
+
+private:
+    void append(std::string& text, int c)
+    {
+        if ( c == '\n' ) line++;
+        text += (char)c;
+    }
+
+    /** Skip a comment, declaration or processing instruction */
+    void skipMarkup()
+    {
+        std::string tail;
+        int c = buf->sbumpc();
+        const char* terminator = ">";
+        if ( c == '?' ) terminator = "?>";
+        else if ( buf->sgetc() == '-' ) terminator = "-->";
+        size_t len = strlen(terminator);
+
+        while ( (c = buf->sbumpc()) != EOF ) {
+            if ( c == '\n' ) line++;
+            tail += (char)c;
+            if ( tail.size() > len ) tail.erase(0, 1);
+            if ( tail == terminator ) return;
+        }
+    }
+
+    std::streambuf* buf;
+    int line;
+    int token_line;
+};
+
+
+std::string trim(const char* str)
+{
+    if ( str == NULL ) return "";
+    const char* end = str + strlen(str);
+    while ( str < end && isspace(*str) ) str++;
+    while ( end > str && isspace(*(end - 1)) ) end--;
+    return std::string(str, end);
+}
+
+}
+
+
+SSTSDLModelDefinition::SSTSDLModelDefinition(const std::string& script_file, int verbosity, Config* configObj) :
+    SSTModelDescription(), fileName(script_file), config(configObj), graph(NULL), nextComponentId(0), line(0)
+{
+    output = new Output("SSTSDLModel ", verbosity, 0, SST::Output::STDOUT);
+}
+
+SSTSDLModelDefinition::~SSTSDLModelDefinition()
+{
+    delete output;
+}
+
+
+ConfigGraph* SSTSDLModelDefinition::createConfigGraph()
+{
+    output->verbose(CALL_INFO, 1, 0, "Creating config graph for SST using SDL model from %s...\n", fileName.c_str());
+
+    std::ifstream in(fileName.c_str());
+    if ( !in ) {
+        output->fatal(CALL_INFO, -1, "Unable to open SDL file %s\n", fileName.c_str());
+    }
+
+    // The config section is split into lines, so line breaks in
+    // element text have to be kept.  The setting is global to TinyXML,
+    // so it is put back once the file is read.
+    bool condense = TiXmlBase::IsWhiteSpaceCondensed();
+    TiXmlBase::SetCondenseWhiteSpace(false);
+
+    graph = new ConfigGraph();
+    graph->beginBulkLoad();
+
+    SDLReader reader(in);
+    SDLReader::Token token;
+    std::string text, name;
+    bool in_graph = false;
+
+    while ( (token = reader.next(text, name)) != SDLReader::DONE ) {
+        line = reader.getLine();
+
+        // The sdl element is often written as an empty tag at the top
+        // of the file rather than wrapping everything, so it carries no
+        // structure
+        if ( token == SDLReader::TEXT || name == "sdl" ) continue;
+
+        if ( token == SDLReader::START && name == "sst" ) {
+            in_graph = true;
+            continue;
+        }
+        if ( token == SDLReader::END ) {
+            if ( name == "sst" ) in_graph = false;
+            continue;
+        }
+
+        if ( token == SDLReader::START && !reader.readElement(text) ) {
+            output->fatal(CALL_INFO, -1, "%s:%d: element <%s> is not closed\n", fileName.c_str(), line, name.c_str());
+        }
+
+        TiXmlDocument doc;
+        doc.Parse(text.c_str());
+        if ( doc.Error() ) {
+            output->fatal(CALL_INFO, -1, "%s:%d: error parsing <%s>: %s\n", fileName.c_str(),
+                          line + doc.ErrorRow() - 1, name.c_str(), doc.ErrorDesc());
+        }
+        TiXmlElement* node = doc.RootElement();
+
+        if ( in_graph ) {
+            if ( name == "component" ) buildComponent(node);
+        }
+        else if ( name == "variables" ) processVariables(node);
+        else if ( name == "param_include" ) processParamSets(node);
+        else if ( name == "config" ) processConfig(node);
+        else if ( name == "timebase" ) processTimebase(node);
+    }
+    TiXmlBase::SetCondenseWhiteSpace(condense);
+
+    output->verbose(CALL_INFO, 1, 0, "Construction of config graph from SDL is complete (%" PRIu64 " components).\n",
+                    (uint64_t)nextComponentId);
+
+    return graph;
+}
+
+
+std::string SSTSDLModelDefinition::processString(const std::string& str)
+{
+    size_t pos = str.find('$');
+    if ( pos == std::string::npos ) return str;
+
+    std::string result(str, 0, pos);
+    while ( pos < str.size() ) {
+        if ( str[pos] != '$' || pos + 1 == str.size() ) {
+            result += str[pos++];
+            continue;
+        }
+
+        if ( str[pos + 1] == '{' ) {
+            size_t close = str.find('}', pos);
+            if ( close == std::string::npos ) {
+                result.append(str, pos, std::string::npos);
+                break;
+            }
+            const char* env = getenv(str.substr(pos + 2, close - pos - 2).c_str());
+            if ( env ) result += env;
+            pos = close + 1;
+            continue;
+        }
+
+        size_t end = pos + 1;
+        while ( end < str.size() && (isalnum(str[end]) || str[end] == '_') ) end++;
+        if ( end == pos + 1 ) {
+            result += str[pos++];
+            continue;
+        }
+
+        std::string var = str.substr(pos + 1, end - pos - 1);
+        auto itr = variables.find(var);
+        if ( itr == variables.end() ) {
+            output->fatal(CALL_INFO, -1, "%s:%d: unknown variable $%s\n", fileName.c_str(), line, var.c_str());
+        }
+        result += itr->second;
+        pos = end;
+    }
+    return result;
+}
+
+
+std::string SSTSDLModelDefinition::getAttribute(TiXmlElement* node, const char* attr, bool required)
+{
+    const char* val = node->Attribute(attr);
+    if ( val == NULL ) {
+        if ( required ) {
+            output->fatal(CALL_INFO, -1, "%s:%d: <%s> is missing the '%s' attribute\n",
+                          fileName.c_str(), line, node->Value(), attr);
+        }
+        return "";
+    }
+    return processString(val);
+}
+
+
+void SSTSDLModelDefinition::processVariables(TiXmlElement* node)
+{
+    for ( TiXmlElement* var = node->FirstChildElement(); var != NULL; var = var->NextSiblingElement() ) {
+        variables[var->Value()] = processString(trim(var->GetText()));
+    }
+}
+
+
+void SSTSDLModelDefinition::processParamSets(TiXmlElement* node)
+{
+    for ( TiXmlElement* group = node->FirstChildElement(); group != NULL; group = group->NextSiblingElement() ) {
+        Params& params = paramSets[group->Value()];
+        params.enableVerify(false);
+        for ( TiXmlElement* p = group->FirstChildElement(); p != NULL; p = p->NextSiblingElement() ) {
+            params.insert(p->Value(), processString(trim(p->GetText())));
+        }
+    }
+}
+
+
+void SSTSDLModelDefinition::processConfig(TiXmlElement* node)
+{
+    std::string text = trim(node->GetText());
+    size_t start = 0;
+    while ( start < text.size() ) {
+        size_t end = text.find('\n', start);
+        if ( end == std::string::npos ) end = text.size();
+        std::string entry = trim(text.substr(start, end - start).c_str());
+        start = end + 1;
+
+        if ( entry.empty() ) continue;
+        size_t eq = entry.find('=');
+        if ( eq == std::string::npos ) {
+            output->fatal(CALL_INFO, -1, "%s:%d: config entry '%s' is not of the form option=value\n",
+                          fileName.c_str(), line, entry.c_str());
+        }
+        config->setConfigEntryFromModel(trim(entry.substr(0, eq).c_str()),
+                                        processString(trim(entry.substr(eq + 1).c_str())));
+    }
+}
+
+
+void SSTSDLModelDefinition::processTimebase(TiXmlElement* node)
+{
+    config->setConfigEntryFromModel("timebase", processString(trim(node->GetText())));
+}
+
+
+void SSTSDLModelDefinition::buildComponent(TiXmlElement* node)
+{
+    ComponentId_t id = nextComponentId++;
+    graph->addComponent(id, getAttribute(node, "name"), getAttribute(node, "type"));
+    ConfigComponent* comp = graph->findComponent(id);
+
+    // Parameters given on the component take precedence over included
+    // sets, and later sets over earlier ones.  Params::insert(Params)
+    // does not overwrite, so the sets are merged last, in reverse.
+    TiXmlElement* params = node->FirstChildElement("params");
+    if ( params != NULL ) {
+        for ( TiXmlElement* p = params->FirstChildElement(); p != NULL; p = p->NextSiblingElement() ) {
+            comp->addParameter(p->Value(), processString(trim(p->GetText())), true);
+        }
+
+        std::string include = getAttribute(params, "include", false);
+        if ( !include.empty() ) {
+            std::vector<std::string> sets;
+            size_t start = 0;
+            while ( start <= include.size() ) {
+                size_t end = include.find(',', start);
+                if ( end == std::string::npos ) end = include.size();
+                sets.push_back(trim(include.substr(start, end - start).c_str()));
+                start = end + 1;
+            }
+            for ( auto itr = sets.rbegin(); itr != sets.rend(); ++itr ) {
+                auto set = paramSets.find(*itr);
+                if ( set == paramSets.end() ) {
+                    output->fatal(CALL_INFO, -1, "%s:%d: unknown parameter set '%s'\n",
+                                  fileName.c_str(), line, itr->c_str());
+                }
+                comp->params.insert(set->second);
+            }
+        }
+    }
+
+    for ( TiXmlElement* link = node->FirstChildElement("link"); link != NULL; link = link->NextSiblingElement("link") ) {
+        graph->addLink(id, getAttribute(link, "name"), getAttribute(link, "port"), getAttribute(link, "latency"));
+    }
+
+    // Identical components share one copy of their parameters
+    sharedParams.intern(comp->params);
+
+    std::string rank = getAttribute(node, "rank", false);
+    if ( !rank.empty() ) comp->setRank(RankInfo(strtoul(rank.c_str(), NULL, 10), 0));
+    std::string weight = getAttribute(node, "weight", false);
+    if ( !weight.empty() ) comp->setWeight(atof(weight.c_str()));
+}
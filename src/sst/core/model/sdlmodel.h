@@ -0,0 +1,78 @@
+// -*- c++ -*-
+
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef SST_CORE_MODEL_SDL
+#define SST_CORE_MODEL_SDL
+
+#include <map>
+#include <string>
+
+#include <sst/core/model/sstmodel.h>
+#include <sst/core/config.h>
+#include <sst/core/output.h>
+#include <sst/core/params.h>
+#include <sst/core/configGraph.h>
+
+class TiXmlElement;
+
+namespace SST {
+namespace Core {
+
+/**
+ * Builds a ConfigGraph directly from an XML (SDL) file, without going
+ * through the Python model.
+ *
+ * The file is read as a stream: the variables, param_include, config
+ * and timebase sections are parsed as they are found, and each
+ * component inside the sst section is parsed, added to the graph and
+ * then discarded.  Only one component is held as a document tree at a
+ * time, so memory use does not grow with the size of the file.
+ * Variables and parameter sets must therefore be defined before the
+ * sst section that uses them.
+ */
+class SSTSDLModelDefinition : public SSTModelDescription {
+
+	public:
+		SSTSDLModelDefinition(const std::string& script_file, int verbosity, Config* config);
+		virtual ~SSTSDLModelDefinition();
+
+		ConfigGraph* createConfigGraph() override;
+
+	protected:
+		void processVariables(TiXmlElement* node);
+		void processParamSets(TiXmlElement* node);
+		void processConfig(TiXmlElement* node);
+		void processTimebase(TiXmlElement* node);
+		void buildComponent(TiXmlElement* node);
+
+		/** Substitute ${ENV} and $variable references in a string */
+		std::string processString(const std::string& str);
+		std::string getAttribute(TiXmlElement* node, const char* attr, bool required = true);
+
+		std::string fileName;
+		Output* output;
+		Config* config;
+		ConfigGraph* graph;
+		ComponentId_t nextComponentId;
+		int line;
+
+		std::map<std::string, std::string> variables;
+		std::map<std::string, Params> paramSets;
+		Params::SharedSetTable sharedParams;
+};
+
+}
+}
+
+#endif
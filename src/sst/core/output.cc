@@ -25,6 +25,7 @@
 
 // Core Headers
 #include "sst/core/simulation.h"
+#include "sst/core/interprocess/shmcomm.h"
 #include <sst/core/warnmacros.h>
 
 #ifdef SST_CONFIG_HAVE_MPI
@@ -205,12 +206,20 @@ void Output::fatal(uint32_t line, const char* file, const char* func,
 
     Simulation::emergencyShutdown();
 
+    // Ranks spawned with --shm-ranks must not touch MPI
+    if ( Core::Interprocess::ShmComm::active() ) {
+        Core::Interprocess::ShmComm::get()->abort(exit_code);
+    }
+
 #ifdef SST_CONFIG_HAVE_MPI
-    // If MPI exists, abort
-    MPI_Abort(MPI_COMM_WORLD, exit_code);
-#else
-    exit(exit_code);
+    // If MPI exists, abort.  It is not initialized in --shm-ranks mode.
+    int mpi_initialized = 0;
+    MPI_Initialized(&mpi_initialized);
+    if ( mpi_initialized ) {
+        MPI_Abort(MPI_COMM_WORLD, exit_code);
+    }
 #endif
+    exit(exit_code);
 }
 
 
@@ -13,6 +13,7 @@
 #include <sst_config.h>
 #include <sst/core/params.h>
 
+#include <functional>
 #include <map>
 #include <vector>
 #include <string>
@@ -23,3 +24,59 @@ std::vector<std::string> SST::Params::keyMapReverse;
 SST::Core::ThreadSafe::Spinlock SST::Params::keyLock;
 uint32_t SST::Params::nextKeyID;
 bool SST::Params::g_verify_enabled = false;
+std::atomic<const SST::Params::KeySnapshot_t*> SST::Params::keySnapshot(NULL);
+std::unique_ptr<const SST::Params::KeySnapshot_t> SST::Params::keySnapshotOwner;
+std::atomic<bool> SST::Params::keysAddedSinceSnapshot(false);
+std::atomic<bool> SST::Params::convertedFrozen(false);
+thread_local SST::Params::SharedSetTable* SST::Params::serializeTable = NULL;
+
+
+void SST::Params::SharedSetTable::intern(Params& p)
+{
+    if ( index.count(p.data.get()) ) return;
+
+    size_t hash = p.data->values.size();
+    for ( auto& kv : p.data->values ) {
+        hash = hash * 31 + kv.first;
+        hash ^= std::hash<std::string>()(kv.second) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+
+    auto range = by_hash.equal_range(hash);
+    for ( auto i = range.first; i != range.second; ++i ) {
+        if ( sets[i->second]->values == p.data->values ) {
+            p.data = sets[i->second];
+            return;
+        }
+    }
+
+    uint32_t id = sets.size();
+    sets.push_back(p.data);
+    index[p.data.get()] = id;
+    by_hash.insert(std::make_pair(hash, id));
+}
+
+void SST::Params::SharedSetTable::serialize_order(SST::Core::Serialization::serializer &ser)
+{
+    uint32_t count = sets.size();
+    ser & count;
+    if ( ser.mode() == SST::Core::Serialization::serializer::UNPACK ) {
+        sets.resize(count);
+        for ( uint32_t i = 0; i < count; i++ ) {
+            sets[i] = std::make_shared<ParamData>();
+        }
+    }
+    for ( uint32_t i = 0; i < count; i++ ) {
+        ser & sets[i]->values;
+    }
+}
+
+
+void SST::Params::publishKeyMap()
+{
+    std::lock_guard<SST::Core::ThreadSafe::Spinlock> lock(keyLock);
+    // Readers may hold the snapshot at any time, so it is never
+    // replaced, and is only freed when the process exits
+    if ( keySnapshot.load() != NULL ) return;
+    keySnapshotOwner.reset(new KeySnapshot_t(keyMap.begin(), keyMap.end()));
+    keySnapshot.store(keySnapshotOwner.get(), std::memory_order_release);
+}
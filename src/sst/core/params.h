@@ -20,8 +20,14 @@
 #include <iostream>
 #include <sstream>
 #include <map>
+#include <memory>
+#include <atomic>
 #include <stack>
 #include <stdlib.h>
+#include <typeindex>
+#include <typeinfo>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <sst/core/threadsafe.h>
 
@@ -34,6 +40,9 @@ int main(int argc, char *argv[]);
 namespace SST {
 
 class ConfigGraph;
+namespace Core {
+class ConfigGraphBinary;
+}
 
 /**
  * Parameter store.
@@ -41,6 +50,11 @@ class ConfigGraph;
  * Stores key-value pairs as std::strings and provides
  * a templated find method for finding values and converting
  * them to arbitrary types (@see find()).
+ *
+ * Copies of a Params share their key-value storage until one of them
+ * is modified, so handing the same set to many components is cheap.
+ * SharedSetTable can be used to make Params with identical contents
+ * share storage as well.
  */
 class Params : public SST::Core::Serialization::serializable {
 private:
@@ -87,7 +101,10 @@ NO_VARIABLE:
         }
     };
 
-    typedef std::map<uint32_t, std::string>::const_iterator const_iterator; /*!< Const Iterator type */
+    typedef std::map<uint32_t, std::string> ParamMap_t;
+    typedef ParamMap_t::const_iterator const_iterator; /*!< Const Iterator type */
+
+    class ParamData;
 
 public:
     typedef std::string key_type;  /*!< Type of key (string) */
@@ -108,13 +125,13 @@ public:
     static void enableVerify() { g_verify_enabled = true; };
 
     /** Returns the size of the Params.  */
-    size_t size() const { return data.size(); }
+    size_t size() const { return data->values.size(); }
     /** Returns true if the Params is empty.  (Thus begin() would equal end().) */
-    bool empty() const { return data.empty(); }
+    bool empty() const { return data->values.empty(); }
 
 
     /** Create a new, empty Params */
-    Params() : data(), verify_enabled(true) { }
+    Params() : data(emptyData()), verify_enabled(true) { }
 
     /** Create a copy of a Params object */
     Params(const Params& old) : data(old.data), allowedKeys(old.allowedKeys), verify_enabled(old.verify_enabled) { }
@@ -125,7 +142,8 @@ public:
      *  @brief  Assignment operator.
      *  @param  old  Param to be copied
      *
-     *  All the elements of old are copied,
+     *  All the elements of old are copied.  The storage is shared
+     *  until either Params is modified.
      */
     Params& operator=(const Params& old) {
         data = old.data;
@@ -137,7 +155,7 @@ public:
     /**
      *  Erases all elements.
      */
-    void clear() { data.clear(); }
+    void clear() { data = emptyData(); }
 
 
     /**
@@ -147,7 +165,7 @@ public:
      *  (either 1 or 0).
      *
      */
-    size_t count(const key_type& k) { return data.count(getKey(k)); }
+    size_t count(const key_type& k) { return data->values.count(getKey(k)); }
 
     /** Find a Parameter value in the set, and return its value as a type T.
      * Type T must be either a basic numeric type (including bool) ,
@@ -163,21 +181,14 @@ public:
     template <class T>
     T find(const std::string &k, T default_value, bool &found) const {
         verifyParam(k);
-        const_iterator i = data.find(getKey(k));
-        if (i == data.end()) {
+        uint32_t key = getKey(k);
+        const_iterator i = data->values.find(key);
+        if (i == data->values.end()) {
             found = false;
             return default_value;
         } else {
             found = true;
-            try {
-                return SST::Core::from_string<T>(i->second);
-            }
-            catch ( const std::invalid_argument& e ) {
-                std::string msg = "Params::find(): No conversion for value: key = " + k + ", value =  " + i->second +
-                    ".  Original error: " + e.what();
-                std::invalid_argument t(msg);
-                throw t;
-            }
+            return convert<T>(k, key, i->second);
         }        
     }
     
@@ -194,29 +205,22 @@ public:
     template <class T>
     T find(const std::string &k, std::string default_value, bool &found) const {
         verifyParam(k);
-        const_iterator i = data.find(getKey(k));
-        if (i == data.end()) {
+        uint32_t key = getKey(k);
+        const_iterator i = data->values.find(key);
+        if (i == data->values.end()) {
             found = false;
             try {
                 return SST::Core::from_string<T>(default_value);
             }
             catch ( const std::invalid_argument& e ) {
-                std::string msg = "Params::find(): Invalid default value specified: key = " + k + ", value =  " + i->second +
+                std::string msg = "Params::find(): Invalid default value specified: key = " + k + ", value =  " + default_value +
                     ".  Original error: " + e.what();
                 std::invalid_argument t(msg);
                 throw t;
             }
         } else {
             found = true;
-            try {
-                return SST::Core::from_string<T>(i->second);
-            }
-            catch ( const std::invalid_argument& e ) {
-                std::string msg = "Params::find(): No conversion for value: key = " + k + ", value =  " + i->second +
-                    ".  Original error: " + e.what();
-                std::invalid_argument t(msg);
-                throw t;
-            }
+            return convert<T>(k, key, i->second);
         }        
     }
     
@@ -291,8 +295,8 @@ public:
     template <class T>
     void find_array(const key_type &k, std::vector<T>& vec) const {
         verifyParam(k);
-        const_iterator i = data.find(getKey(k));
-        if ( i == data.end()) {
+        const_iterator i = data->values.find(getKey(k));
+        if ( i == data->values.end()) {
             return;
         }
         std::string value = i->second;
@@ -329,13 +333,13 @@ public:
 
     /** Print all key/value parameter pairs to specified ostream */
     void print_all_params(std::ostream &os, std::string prefix = "") const {
-        for (const_iterator i = data.begin() ; i != data.end() ; ++i) {
+        for (const_iterator i = data->values.begin() ; i != data->values.end() ; ++i) {
             os << prefix << "key=" << keyMapReverse[i->first] << ", value=" << i->second << std::endl;
         }
     }
 
     void print_all_params(Output &out, std::string prefix = "") const {
-        for (const_iterator i = data.begin() ; i != data.end() ; ++i) {
+        for (const_iterator i = data->values.begin() ; i != data->values.end() ; ++i) {
             out.output("%s%s = %s\n", prefix.c_str(), keyMapReverse[i->first].c_str(), i->second.c_str());
         }
     }
@@ -346,21 +350,29 @@ public:
      */
     void insert(std::string key, std::string value, bool overwrite = true) {
         if ( overwrite ) {
-            data[getKey(key)] = value;
+            mutableData()[getKey(key)] = value;
         }
         else {
             uint32_t id = getKey(key);
-            data.insert(std::make_pair(id, value));
+            mutableData().insert(std::make_pair(id, value));
         }
     }
 
+    /** Add the key value pairs of params that are not already present.
+     *  If this Params is empty, it shares the storage of params.
+     */
     void insert(const Params& params) {
-        data.insert(params.data.begin(), params.data.end());
+        if ( data->values.empty() ) {
+            data = params.data;
+            return;
+        }
+        if ( params.data == data ) return;
+        mutableData().insert(params.data->values.begin(), params.data->values.end());
     }
 
     std::set<std::string> getKeys() const {
         std::set<std::string> ret;
-        for (const_iterator i = data.begin() ; i != data.end() ; ++i) {
+        for (const_iterator i = data->values.begin() ; i != data->values.end() ; ++i) {
             ret.insert(keyMapReverse[i->first]);
         }
         return ret;
@@ -372,7 +384,7 @@ public:
     Params find_prefix_params(std::string prefix) const {
         Params ret;
         ret.enableVerify(false);
-        for (const_iterator i = data.begin() ; i != data.end() ; ++i) {
+        for (const_iterator i = data->values.begin() ; i != data->values.end() ; ++i) {
             std::string key = keyMapReverse[i->first].substr(0, prefix.length());
             if (key == prefix) {
                 ret.insert(keyMapReverse[i->first].substr(prefix.length()), i->second);
@@ -390,7 +402,7 @@ public:
      * @return    True if the params contains the key, false otherwise
      */
     bool contains(const key_type &k) {
-        return data.find(getKey(k)) != data.end();
+        return data->values.find(getKey(k)) != data->values.end();
     }
 
     /**
@@ -437,20 +449,213 @@ public:
     }
 
 
+    /**
+     * Table of distinct parameter sets.
+     *
+     * intern() makes Params with identical contents share one copy of
+     * their storage.  While a table is active (see setSerializeTable()),
+     * Params serialized on the same thread are written as an index into
+     * the table when their set is in it, so the table only has to be
+     * serialized once for all of them.  The table has to be unpacked
+     * before any of the Params that refer to it.
+     */
+    class SharedSetTable {
+    public:
+        /** Share storage between p and any Params with the same contents interned earlier */
+        void intern(Params& p);
+        /** Number of distinct sets in the table */
+        size_t size() const { return sets.size(); }
+
+        void serialize_order(SST::Core::Serialization::serializer &ser);
+
+    private:
+        friend class Params;
+        static const uint32_t NOT_SHARED = (uint32_t)-1;
+
+        uint32_t find(const ParamData* set) const {
+            auto i = index.find(set);
+            return i == index.end() ? NOT_SHARED : i->second;
+        }
+
+        std::vector<std::shared_ptr<ParamData> > sets;
+        std::unordered_map<const ParamData*, uint32_t> index;
+        std::unordered_multimap<size_t, uint32_t> by_hash;
+    };
+
+    /**
+     * Set the table used when serializing Params on this thread.
+     * Returns the previous table.  Pass NULL to serialize every set in
+     * place.
+     */
+    static SharedSetTable* setSerializeTable(SharedSetTable* table) {
+        SharedSetTable* prev = serializeTable;
+        serializeTable = table;
+        return prev;
+    }
+
     void serialize_order(SST::Core::Serialization::serializer &ser) override {
-        ser & data;
-    }    
-    
+        uint32_t set_id = SharedSetTable::NOT_SHARED;
+        if ( serializeTable != NULL ) {
+            if ( ser.mode() != SST::Core::Serialization::serializer::UNPACK ) {
+                set_id = serializeTable->find(data.get());
+            }
+            ser & set_id;
+        }
+
+        if ( set_id != SharedSetTable::NOT_SHARED ) {
+            if ( ser.mode() == SST::Core::Serialization::serializer::UNPACK ) {
+                data = serializeTable->sets[set_id];
+            }
+            return;
+        }
+        if ( ser.mode() == SST::Core::Serialization::serializer::UNPACK ) {
+            data = std::make_shared<ParamData>();
+        }
+        ser & data->values;
+    }
+
+    /**
+     * Make a read-only copy of the key table that find() can search
+     * without taking the table's lock.  Called once the graph has been
+     * built and distributed, before the simulation threads start.  Keys
+     * added afterwards are still found through the locked table.
+     */
+    static void publishKeyMap();
+
+    /**
+     * Stop adding to the converted value caches, so that find() can
+     * read them without taking a lock.  Called once the components
+     * are wired up and set up, between thread barriers, so that no
+     * thread is adding a value at the time.  Values first found
+     * afterwards are converted on every call.
+     */
+    static void freezeConverted() {
+        convertedFrozen.store(true, std::memory_order_release);
+    }
+
     ImplementSerializable(SST::Params)
 
 private:
-    std::map<uint32_t, std::string> data;
+    /**
+     * Storage shared between copies of a Params: the key-value pairs,
+     * and the values that find() has already converted, by key and
+     * type.  A converted value is never removed while the storage is
+     * shared; clearConverted() only runs when a single Params holds the
+     * storage and is about to modify it (see mutableData()).  A pointer
+     * from getConverted() is therefore only valid until that Params is
+     * next modified, so find() returns converted values by copy.  Once
+     * the caches are frozen nothing is added, and they are read without
+     * the lock.
+     */
+    class ParamData {
+    public:
+        ParamMap_t values;
+
+        ParamData() { }
+        /** Copies the values only; nothing has been converted for the copy */
+        ParamData(const ParamData& old) : values(old.values) { }
+
+        template <class T>
+        const T* getConverted(uint32_t key) {
+            if ( convertedFrozen.load(std::memory_order_acquire) ) return findConverted<T>(key);
+            std::lock_guard<SST::Core::ThreadSafe::Spinlock> lock(convertedLock);
+            return findConverted<T>(key);
+        }
+
+        template <class T>
+        void addConverted(uint32_t key, const T& value) {
+            if ( convertedFrozen.load(std::memory_order_acquire) ) return;
+            std::lock_guard<SST::Core::ThreadSafe::Spinlock> lock(convertedLock);
+            auto k = std::make_pair(key, std::type_index(typeid(T)));
+            if ( converted.find(k) == converted.end() ) {
+                converted[k].reset(new ConvertedValue<T>(value));
+            }
+        }
+
+        /** Only called when the storage is not shared */
+        void clearConverted() { converted.clear(); }
+
+    private:
+        struct ConvertedValueBase {
+            virtual ~ConvertedValueBase() { }
+        };
+        template <class T>
+        struct ConvertedValue : public ConvertedValueBase {
+            T value;
+            ConvertedValue(const T& value) : value(value) { }
+        };
+
+        template <class T>
+        const T* findConverted(uint32_t key) const {
+            auto i = converted.find(std::make_pair(key, std::type_index(typeid(T))));
+            if ( i == converted.end() ) return NULL;
+            return &static_cast<ConvertedValue<T>*>(i->second.get())->value;
+        }
+
+        std::map<std::pair<uint32_t, std::type_index>, std::unique_ptr<ConvertedValueBase> > converted;
+        SST::Core::ThreadSafe::Spinlock convertedLock;
+    };
+
+    std::shared_ptr<ParamData> data;
     std::vector<KeySet_t> allowedKeys;
     bool verify_enabled;
     static bool g_verify_enabled;
+    static thread_local SharedSetTable* serializeTable;
+
+    /** Shared storage for empty Params, so they need no allocation */
+    static const std::shared_ptr<ParamData>& emptyData() {
+        static const std::shared_ptr<ParamData> empty = std::make_shared<ParamData>();
+        return empty;
+    }
+
+    /** Storage that can be modified, copying it first if it is shared */
+    ParamMap_t& mutableData() {
+        if ( data.use_count() > 1 ) {
+            data = std::make_shared<ParamData>(*data);
+        }
+        else {
+            data->clearConverted();
+        }
+        return data->values;
+    }
+
+    /* A std::string needs no conversion, so it is returned directly */
+    template <class T>
+    typename std::enable_if<std::is_same<T, std::string>::value, T>::type
+    convert(const std::string&, uint32_t, const std::string& value) const {
+        return value;
+    }
+
+    /* Other types are converted once per set and key, then reused */
+    template <class T>
+    typename std::enable_if<!std::is_same<T, std::string>::value, T>::type
+    convert(const std::string& k, uint32_t key, const std::string& value) const {
+        const T* prev = data->template getConverted<T>(key);
+        if ( prev != NULL ) return *prev;
+        try {
+            T ret = SST::Core::from_string<T>(value);
+            data->addConverted(key, ret);
+            return ret;
+        }
+        catch ( const std::invalid_argument& e ) {
+            std::string msg = "Params::find(): No conversion for value: key = " + k + ", value =  " + value +
+                ".  Original error: " + e.what();
+            std::invalid_argument t(msg);
+            throw t;
+        }
+    }
+
+    typedef std::unordered_map<std::string, uint32_t> KeySnapshot_t;
 
     uint32_t getKey(const std::string &str) const
     {
+        const KeySnapshot_t* snapshot = keySnapshot.load(std::memory_order_acquire);
+        if ( snapshot != NULL ) {
+            KeySnapshot_t::const_iterator i = snapshot->find(str);
+            if ( i != snapshot->end() ) return i->second;
+            if ( !keysAddedSinceSnapshot.load(std::memory_order_acquire) ) return (uint32_t)-1;
+        }
+
         std::lock_guard<SST::Core::ThreadSafe::Spinlock> lock(keyLock);
         std::map<std::string, uint32_t>::iterator i = keyMap.find(str);
         if ( i == keyMap.end() ) {
@@ -461,6 +666,12 @@ private:
 
     uint32_t getKey(const std::string &str)
     {
+        const KeySnapshot_t* snapshot = keySnapshot.load(std::memory_order_acquire);
+        if ( snapshot != NULL ) {
+            KeySnapshot_t::const_iterator i = snapshot->find(str);
+            if ( i != snapshot->end() ) return i->second;
+        }
+
         std::lock_guard<SST::Core::ThreadSafe::Spinlock> lock(keyLock);
         std::map<std::string, uint32_t>::iterator i = keyMap.find(str);
         if ( i == keyMap.end() ) {
@@ -468,6 +679,7 @@ private:
             keyMap.insert(std::make_pair(str, id));
             keyMapReverse.push_back(str);
             assert(keyMapReverse.size() == nextKeyID);
+            if ( snapshot != NULL ) keysAddedSinceSnapshot.store(true, std::memory_order_release);
             return id;
         }
         return i->second;
@@ -475,11 +687,18 @@ private:
 
     /* Friend main() because it broadcasts the maps */
     friend int ::main(int argc, char *argv[]);
+    /* Saves and restores the maps with binary graph files */
+    friend class SST::Core::ConfigGraphBinary;
 
     static std::map<std::string, uint32_t> keyMap;
     static std::vector<std::string> keyMapReverse;
     static SST::Core::ThreadSafe::Spinlock keyLock;
     static uint32_t nextKeyID;
+    static std::atomic<const KeySnapshot_t*> keySnapshot;
+    /** Owns the snapshot; it lives until the process exits */
+    static std::unique_ptr<const KeySnapshot_t> keySnapshotOwner;
+    static std::atomic<bool> keysAddedSinceSnapshot;
+    static std::atomic<bool> convertedFrozen;
 
 
 };
@@ -0,0 +1,240 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/partitionReport.h>
+
+#include <sst/core/configGraph.h>
+#include <sst/core/output.h>
+#include <sst/core/simulation.h>
+#include <sst/core/timeLord.h>
+#include <sst/core/unitAlgebra.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+namespace SST {
+namespace Core {
+
+PartitionReport::PartitionReport(ConfigGraph* graph, const RankInfo& world_size, bool threads_known, double events_per_weight) :
+    world_size(world_size),
+    threads_known(threads_known && world_size.thread > 1),
+    events_per_weight(events_per_weight),
+    num_components(0),
+    num_links(0),
+    total_weight(0),
+    rank_cut_links(0),
+    rank_cut_weight(0),
+    thread_cut_links(0),
+    min_part(MAX_SIMTIME_T),
+    min_thread_latency(MAX_SIMTIME_T)
+{
+    ConfigComponentMap_t& comps = graph->getComponentMap();
+    ConfigLinkMap_t& links = graph->getLinkMap();
+
+    PartStats empty = { 0, 0, 0, 0 };
+    ranks.assign(world_size.rank, empty);
+    if ( this->threads_known ) threads.assign(world_size.rank * world_size.thread, empty);
+
+    for ( ConfigComponent& comp : comps ) {
+        num_components++;
+        total_weight += comp.weight;
+        ranks[comp.rank.rank].components++;
+        ranks[comp.rank.rank].weight += comp.weight;
+        if ( this->threads_known ) {
+            PartStats& t = threads[comp.rank.rank * world_size.thread + comp.rank.thread];
+            t.components++;
+            t.weight += comp.weight;
+        }
+    }
+
+    // Rank pairs are found through a hash so the pass stays linear in
+    // the number of links
+    std::unordered_map<uint64_t, size_t> pair_index;
+    for ( ConfigLink& link : links ) {
+        num_links++;
+        const RankInfo& r0 = comps[COMPONENT_ID_MASK(link.component[0])].rank;
+        const RankInfo& r1 = comps[COMPONENT_ID_MASK(link.component[1])].rank;
+        SimTime_t latency = link.getMinLatency();
+
+        if ( r0.rank != r1.rank ) {
+            rank_cut_links++;
+            rank_cut_weight += link.weight;
+            min_part = std::min(min_part, latency);
+            for ( uint32_t r : { r0.rank, r1.rank } ) {
+                ranks[r].cut_links++;
+                ranks[r].cut_weight += link.weight;
+            }
+
+            uint32_t lo = std::min(r0.rank, r1.rank);
+            uint32_t hi = std::max(r0.rank, r1.rank);
+            uint64_t key = (uint64_t)lo * world_size.rank + hi;
+            auto it = pair_index.find(key);
+            if ( it == pair_index.end() ) {
+                it = pair_index.insert(std::make_pair(key, pairs.size())).first;
+                PairStats p = { { lo, hi }, 0, 0, MAX_SIMTIME_T };
+                pairs.push_back(p);
+            }
+            PairStats& p = pairs[it->second];
+            p.links++;
+            p.weight += link.weight;
+            p.min_latency = std::min(p.min_latency, latency);
+        }
+        else if ( r0.thread != r1.thread && this->threads_known ) {
+            thread_cut_links++;
+            min_thread_latency = std::min(min_thread_latency, latency);
+        }
+
+        if ( this->threads_known && r0 != r1 ) {
+            for ( const RankInfo* r : { &r0, &r1 } ) {
+                PartStats& t = threads[r->rank * world_size.thread + r->thread];
+                t.cut_links++;
+                t.cut_weight += link.weight;
+            }
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end(), [](const PairStats& a, const PairStats& b) {
+            if ( a.rank[0] != b.rank[0] ) return a.rank[0] < b.rank[0];
+            return a.rank[1] < b.rank[1];
+        });
+}
+
+double
+PartitionReport::imbalance(const std::vector<PartStats>& parts)
+{
+    if ( parts.empty() ) return 0;
+    double total = 0;
+    double max_weight = 0;
+    for ( const PartStats& p : parts ) {
+        total += p.weight;
+        max_weight = std::max(max_weight, p.weight);
+    }
+    double avg = total / parts.size();
+    return avg > 0 ? (max_weight - avg) / avg : 0;
+}
+
+std::string
+PartitionReport::timeString(SimTime_t time) const
+{
+    return (Simulation::getTimeLord()->getTimeBase() * time).toStringBestSI();
+}
+
+void
+PartitionReport::print(Output& out) const
+{
+    out.output("# Partition report: %" PRIu64 " components and %" PRIu64 " links on %" PRIu32 " ranks with %" PRIu32 " threads each\n",
+               num_components, num_links, world_size.rank, world_size.thread);
+
+    if ( world_size.rank > 1 ) {
+        out.output("#   Cut between ranks: %" PRIu64 " links (%.2f%%), weight %.6g, across %zu rank pairs\n",
+                   rank_cut_links, num_links ? 100.0 * rank_cut_links / num_links : 0.0, rank_cut_weight, pairs.size());
+        out.output("#   Heaviest rank is %.1f%% above the average weight\n", 100.0 * imbalance(ranks));
+        if ( min_part == MAX_SIMTIME_T ) {
+            out.output("#   No links cross a rank boundary\n");
+        }
+        else {
+            double period = Simulation::getTimeLord()->getTimeBase().getValue().toDouble() * min_part;
+            out.output("#   min_part is %s, predicting %.6g rank syncs per simulated microsecond\n",
+                       timeString(min_part).c_str(), 1e-6 / period);
+        }
+        if ( events_per_weight > 0 ) {
+            out.output("#   Expected cross-rank events (from the component profile): %.6g\n", rank_cut_weight * events_per_weight);
+        }
+    }
+    if ( threads_known ) {
+        out.output("#   Cut between threads of a rank: %" PRIu64 " links (%.2f%%)\n",
+                   thread_cut_links, num_links ? 100.0 * thread_cut_links / num_links : 0.0);
+        out.output("#   Heaviest thread is %.1f%% above the average weight\n", 100.0 * imbalance(threads));
+        if ( min_thread_latency != MAX_SIMTIME_T ) {
+            out.output("#   Minimum cross-thread link latency is %s\n", timeString(min_thread_latency).c_str());
+        }
+    }
+}
+
+static void writePart(FILE* fp, const char* indent, const char* kind, uint32_t index,
+                      uint64_t components, double weight, uint64_t cut_links, double cut_weight)
+{
+    fprintf(fp, "%s{ \"%s\" : %" PRIu32 ", \"components\" : %" PRIu64 ", \"weight\" : %.9g, \"cut_links\" : %" PRIu64 ", \"cut_weight\" : %.9g",
+            indent, kind, index, components, weight, cut_links, cut_weight);
+}
+
+void
+PartitionReport::write(const std::string& file) const
+{
+    Output& out = Output::getDefaultObject();
+    FILE* fp = fopen(file.c_str(), "w");
+    if ( fp == NULL ) {
+        out.fatal(CALL_INFO, 1, "Unable to open partition report %s for writing: %s\n", file.c_str(), strerror(errno));
+    }
+
+    // Latencies are in core time units; time_base converts them
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"num_ranks\" : %" PRIu32 ",\n", world_size.rank);
+    fprintf(fp, "  \"num_threads\" : %" PRIu32 ",\n", world_size.thread);
+    fprintf(fp, "  \"num_components\" : %" PRIu64 ",\n", num_components);
+    fprintf(fp, "  \"num_links\" : %" PRIu64 ",\n", num_links);
+    fprintf(fp, "  \"total_weight\" : %.9g,\n", total_weight);
+    fprintf(fp, "  \"time_base\" : \"%s\",\n", Simulation::getTimeLord()->getTimeBase().toStringBestSI().c_str());
+    if ( min_part == MAX_SIMTIME_T ) fprintf(fp, "  \"min_part\" : null,\n");
+    else fprintf(fp, "  \"min_part\" : %" PRIu64 ",\n", min_part);
+    fprintf(fp, "  \"rank_cut_links\" : %" PRIu64 ",\n", rank_cut_links);
+    fprintf(fp, "  \"rank_cut_weight\" : %.9g,\n", rank_cut_weight);
+    if ( events_per_weight > 0 ) fprintf(fp, "  \"expected_cross_rank_events\" : %.9g,\n", rank_cut_weight * events_per_weight);
+    fprintf(fp, "  \"rank_imbalance\" : %.9g,\n", imbalance(ranks));
+    if ( threads_known ) {
+        fprintf(fp, "  \"thread_cut_links\" : %" PRIu64 ",\n", thread_cut_links);
+        if ( min_thread_latency == MAX_SIMTIME_T ) fprintf(fp, "  \"min_thread_latency\" : null,\n");
+        else fprintf(fp, "  \"min_thread_latency\" : %" PRIu64 ",\n", min_thread_latency);
+        fprintf(fp, "  \"thread_imbalance\" : %.9g,\n", imbalance(threads));
+    }
+
+    fprintf(fp, "  \"ranks\" : [\n");
+    for ( uint32_t r = 0; r < world_size.rank; r++ ) {
+        const PartStats& rs = ranks[r];
+        writePart(fp, "    ", "rank", r, rs.components, rs.weight, rs.cut_links, rs.cut_weight);
+        if ( threads_known ) {
+            fprintf(fp, ",\n      \"threads\" : [\n");
+            for ( uint32_t t = 0; t < world_size.thread; t++ ) {
+                const PartStats& ts = threads[r * world_size.thread + t];
+                writePart(fp, "        ", "thread", t, ts.components, ts.weight, ts.cut_links, ts.cut_weight);
+                fprintf(fp, " }%s\n", t + 1 < world_size.thread ? "," : "");
+            }
+            fprintf(fp, "      ]\n    ");
+        }
+        else {
+            fprintf(fp, " ");
+        }
+        fprintf(fp, "}%s\n", r + 1 < world_size.rank ? "," : "");
+    }
+    fprintf(fp, "  ],\n");
+
+    fprintf(fp, "  \"rank_pairs\" : [");
+    for ( size_t i = 0; i < pairs.size(); i++ ) {
+        const PairStats& p = pairs[i];
+        fprintf(fp, "%s    { \"ranks\" : [ %" PRIu32 ", %" PRIu32 " ], \"links\" : %" PRIu64 ", \"weight\" : %.9g, \"min_latency\" : %" PRIu64,
+                i ? ",\n" : "\n", p.rank[0], p.rank[1], p.links, p.weight, p.min_latency);
+        if ( events_per_weight > 0 ) fprintf(fp, ", \"expected_events\" : %.9g", p.weight * events_per_weight);
+        fprintf(fp, " }");
+    }
+    fprintf(fp, "\n  ]\n");
+    fprintf(fp, "}\n");
+    fclose(fp);
+
+    out.verbose(CALL_INFO, 1, 0, "# Wrote partition report to %s\n", file.c_str());
+}
+
+}
+}
@@ -0,0 +1,100 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_PARTITIONREPORT_H
+#define SST_CORE_PARTITIONREPORT_H
+
+#include <sst/core/sst_types.h>
+#include <sst/core/rankInfo.h>
+
+#include <string>
+#include <vector>
+
+namespace SST {
+
+class ConfigGraph;
+class Output;
+
+namespace Core {
+
+/**
+ * Measures the quality of a partition: the links cut between each pair
+ * of ranks, the component count and weight on each rank and thread, the
+ * smallest latency crossing ranks (min_part, which sets the sync period)
+ * and crossing each pair of ranks, and the cross-rank traffic expected
+ * from a component profile.  Enabled with --output-partition-report.
+ *
+ * The analysis is a single pass over the components and links, so it is
+ * cheap enough to run on rank 0 before a large job is launched.
+ */
+class PartitionReport {
+
+public:
+    /**
+     * Analyze a partitioned graph
+     * \param graph The partitioned graph
+     * \param world_size Number of ranks and threads
+     * \param threads_known False if threads are assigned later, on each rank
+     * \param events_per_weight Events per unit of link weight from a
+     *     component profile, or 0 if there is no profile
+     */
+    PartitionReport(ConfigGraph* graph, const RankInfo& world_size, bool threads_known, double events_per_weight);
+
+    /** Print a summary */
+    void print(Output& out) const;
+
+    /** Write the full report to file (in JSON format) */
+    void write(const std::string& file) const;
+
+private:
+    struct PartStats {
+        uint64_t components;
+        double weight;
+        /** Links from this part to another rank */
+        uint64_t cut_links;
+        double cut_weight;
+    };
+
+    struct PairStats {
+        uint32_t rank[2];
+        uint64_t links;
+        double weight;
+        SimTime_t min_latency;
+    };
+
+    static double imbalance(const std::vector<PartStats>& parts);
+    std::string timeString(SimTime_t time) const;
+
+    RankInfo world_size;
+    bool threads_known;
+    double events_per_weight;
+
+    uint64_t num_components;
+    uint64_t num_links;
+    double total_weight;
+
+    std::vector<PartStats> ranks;
+    /** Indexed by rank * threads + thread */
+    std::vector<PartStats> threads;
+    /** Rank pairs joined by at least one link, in rank order */
+    std::vector<PairStats> pairs;
+
+    uint64_t rank_cut_links;
+    double rank_cut_weight;
+    uint64_t thread_cut_links;
+    SimTime_t min_part;
+    SimTime_t min_thread_latency;
+};
+
+}
+}
+
+#endif // SST_CORE_PARTITIONREPORT_H
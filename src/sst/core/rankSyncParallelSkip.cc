@@ -42,6 +42,9 @@ RankSyncParallelSkip::RankSyncParallelSkip(RankInfo num_ranks, TimeConverter* UN
     NewRankSync(),
     mpiWaitTime(0.0),
     deserializeTime(0.0),
+    decompressTime(0.0),
+    compressThreshold(Simulation::getSyncCompressThreshold()),
+    syncCount(0),
     send_count(0),
     serializeReadyBarrier(num_ranks.thread),
     slaveExchangeDoneBarrier(num_ranks.thread),
@@ -59,7 +62,11 @@ RankSyncParallelSkip::RankSyncParallelSkip(RankInfo num_ranks, TimeConverter* UN
 
 RankSyncParallelSkip::~RankSyncParallelSkip()
 {
+    uint64_t compressSaved = 0;
+    double compressTime = 0.0;
     for (auto i = comm_send_map.begin() ; i != comm_send_map.end() ; ++i) {
+        compressSaved += i->second.squeue->getCompressionSavings();
+        compressTime += i->second.squeue->getCompressionTime();
         delete i->second.squeue;
     }
     comm_send_map.clear();
@@ -79,6 +86,10 @@ RankSyncParallelSkip::~RankSyncParallelSkip()
 
     if ( mpiWaitTime > 0.0 || deserializeTime > 0.0 )
         Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "RankSyncParallelSkip mpiWait: %lg sec  deserializeWait:  %lg sec\n", mpiWaitTime, deserializeTime);
+    if ( compressThreshold != 0 && syncCount != 0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "RankSyncParallelSkip compression saved %" PRIu64 " bytes over %" PRIu64 " syncs (%" PRIu64 " bytes/sync), compress: %lg sec  decompress: %lg sec  (%lg us/sync)\n",
+                                           compressSaved, syncCount, compressSaved / syncCount, compressTime, decompressTime,
+                                           1.0e6 * (compressTime + decompressTime) / syncCount);
 }
     
 ActivityQueue* RankSyncParallelSkip::registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link)
@@ -88,7 +99,7 @@ ActivityQueue* RankSyncParallelSkip::registerLink(const RankInfo& to_rank, const
     if ( comm_send_map.count(to_rank) == 0 ) {
         send_count++;
         comm_send_map[to_rank].to_rank = to_rank;
-        queue = comm_send_map[to_rank].squeue = new SyncQueue();
+        queue = comm_send_map[to_rank].squeue = new SyncQueue(compressThreshold);
         comm_send_map[to_rank].remote_size = 4096;
     } else {
         queue = comm_send_map[to_rank].squeue;
@@ -141,7 +152,8 @@ RankSyncParallelSkip::getDataSize() const {
     }
 
     for ( auto it = comm_recv_map.begin(); it != comm_recv_map.end(); ++it ) {
-        count += it->second.local_size;
+        count += it->second.local_size + it->second.dbuf.capacity() +
+            (it->second.activity_vec.capacity() * sizeof(Activity*));
     }
     return count;
 }
@@ -233,6 +245,7 @@ RankSyncParallelSkip::exchange_master(int UNUSED(thread))
     }    
 
     remaining_deser = comm_recv_map.size();
+    syncCount++;
     
     serializeReadyBarrier.wait(); /* Wait for / release slaves to serialize */
     
@@ -262,7 +275,7 @@ RankSyncParallelSkip::exchange_master(int UNUSED(thread))
                 hdr->mode = 1;
                 MPI_Isend(send_buffer, sizeof(SyncQueue::Header), MPI_BYTE,
                           send->to_rank.rank/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
-                send->remote_size = hdr->buffer_size;
+                send->remote_size = SyncQueue::growMessageSize(send->remote_size, hdr->buffer_size);
                 tag = 2 * send->to_rank.thread + 1;
             }
             else {
@@ -304,8 +317,8 @@ RankSyncParallelSkip::exchange_master(int UNUSED(thread))
                         // May need to resize the buffer
                         if ( size > i->second.local_size ) {
                             delete[] i->second.rbuf;
-                            i->second.rbuf = new char[size];
-                            i->second.local_size = size;
+                            i->second.local_size = SyncQueue::growMessageSize(i->second.local_size, size);
+                            i->second.rbuf = new char[i->second.local_size];
                         }
                         MPI_Recv(i->second.rbuf, i->second.local_size, MPI_BYTE,
                                  i->second.remote_rank, 2 * i->second.local_thread + 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
@@ -381,7 +394,7 @@ RankSyncParallelSkip::exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::at
             hdr->mode = 1;
             MPI_Isend(send_buffer, sizeof(SyncQueue::Header), MPI_BYTE,
                       i->second.to_rank.rank/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
-            i->second.remote_size = hdr->buffer_size;
+            i->second.remote_size = SyncQueue::growMessageSize(i->second.remote_size, hdr->buffer_size);
             tag = 2 * i->second.to_rank.thread + 1;
         }
         else {
@@ -409,19 +422,20 @@ RankSyncParallelSkip::exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::at
             // May need to resize the buffer
             if ( size > i->second.local_size ) {
                 delete[] i->second.rbuf;
-                i->second.rbuf = new char[size];
-                i->second.local_size = size;
+                i->second.local_size = SyncQueue::growMessageSize(i->second.local_size, size);
+                i->second.rbuf = new char[i->second.local_size];
             }
             MPI_Recv(i->second.rbuf, i->second.local_size, MPI_BYTE,
                      i->second.remote_rank, 2 * i->second.local_thread + 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
             buffer = i->second.rbuf;
         }
 
-        SST::Core::Serialization::serializer ser;
-        ser.start_unpacking(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-        
-        std::vector<Activity*> activities;
-        ser & activities;
+        size_t payload_size;
+        char* payload = SyncQueue::getPayload(buffer, i->second.dbuf, payload_size);
+
+        std::vector<Activity*>& activities = i->second.activity_vec;
+        i->second.ser.start_unpacking(payload, payload_size);
+        i->second.ser & activities;
 
         for ( unsigned int j = 0; j < activities.size(); j++ ) {
             
@@ -432,7 +446,8 @@ RankSyncParallelSkip::exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::at
             } else {
                 sendUntimedData_sync(link->second,ev);
             }
-        }        
+        }
+        activities.clear();
     }
     
     // Clear the SyncQueues used to send the data after all the sends have completed
@@ -454,16 +469,15 @@ RankSyncParallelSkip::exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::at
 void
 RankSyncParallelSkip::deserializeMessage(comm_recv_pair* msg)
 {
-    char* buffer = msg->rbuf;
-    SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(buffer);
-    unsigned int size = hdr->buffer_size;
-    
+    auto decompressStart = SST::Core::Profile::now();
+    size_t payload_size;
+    char* payload = SyncQueue::getPayload(msg->rbuf, msg->dbuf, payload_size);
+    decompressTime += SST::Core::Profile::getElapsed(decompressStart);
+
     auto deserialStart = SST::Core::Profile::now();
 
-    SST::Core::Serialization::serializer ser;
-    
-    ser.start_unpacking(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-    ser & msg->activity_vec;
+    msg->ser.start_unpacking(payload, payload_size);
+    msg->ser & msg->activity_vec;
 
     deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
 }
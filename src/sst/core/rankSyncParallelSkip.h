@@ -16,6 +16,7 @@
 #include <sst/core/syncManager.h>
 #include <sst/core/threadsafe.h>
 #include <sst/core/warnmacros.h>
+#include <sst/core/serialization/serializer.h>
 
 #include <map>
 
@@ -70,7 +71,9 @@ private:
         uint32_t remote_rank;
         uint32_t local_thread;
         char* rbuf; // receive buffer
+        std::vector<char> dbuf; // decompression buffer
         std::vector<Activity*> activity_vec;
+        SST::Core::Serialization::serializer ser;
         uint32_t local_size;
         bool recv_done;
 #ifdef SST_CONFIG_HAVE_MPI
@@ -89,6 +92,9 @@ private:
 
     double mpiWaitTime;
     double deserializeTime;
+    double decompressTime;
+    uint64_t compressThreshold;
+    uint64_t syncCount;
 
     int* recv_count;
     int send_count;
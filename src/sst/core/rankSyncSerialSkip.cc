@@ -42,7 +42,10 @@ SimTime_t RankSyncSerialSkip::myNextSyncTime = 0;
 RankSyncSerialSkip::RankSyncSerialSkip(TimeConverter* UNUSED(minPartTC)) :
     NewRankSync(),
     mpiWaitTime(0.0),
-    deserializeTime(0.0)
+    deserializeTime(0.0),
+    decompressTime(0.0),
+    compressThreshold(Simulation::getSyncCompressThreshold()),
+    syncCount(0)
 {
     max_period = Simulation::getSimulation()->getMinPartTC();
     myNextSyncTime = max_period->getFactor();
@@ -50,8 +53,13 @@ RankSyncSerialSkip::RankSyncSerialSkip(TimeConverter* UNUSED(minPartTC)) :
 
 RankSyncSerialSkip::~RankSyncSerialSkip()
 {
+    uint64_t compressSaved = 0;
+    double compressTime = 0.0;
     for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        compressSaved += i->second.squeue->getCompressionSavings();
+        compressTime += i->second.squeue->getCompressionTime();
         delete i->second.squeue;
+        delete[] i->second.rbuf;
     }
     comm_map.clear();
     
@@ -62,13 +70,17 @@ RankSyncSerialSkip::~RankSyncSerialSkip()
 
     if ( mpiWaitTime > 0.0 || deserializeTime > 0.0 )
         Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "RankSyncSerialSkip mpiWait: %lg sec  deserializeWait:  %lg sec\n", mpiWaitTime, deserializeTime);
+    if ( compressThreshold != 0 && syncCount != 0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "RankSyncSerialSkip compression saved %" PRIu64 " bytes over %" PRIu64 " syncs (%" PRIu64 " bytes/sync), compress: %lg sec  decompress: %lg sec  (%lg us/sync)\n",
+                                           compressSaved, syncCount, compressSaved / syncCount, compressTime, decompressTime,
+                                           1.0e6 * (compressTime + decompressTime) / syncCount);
 }
     
 ActivityQueue* RankSyncSerialSkip::registerLink(const RankInfo& to_rank, const RankInfo& UNUSED(from_rank), LinkId_t link_id, Link* link)
 {
     SyncQueue* queue;
     if ( comm_map.count(to_rank.rank) == 0 ) {
-        queue = comm_map[to_rank.rank].squeue = new SyncQueue();
+        queue = comm_map[to_rank.rank].squeue = new SyncQueue(compressThreshold);
         comm_map[to_rank.rank].rbuf = new char[4096];
         comm_map[to_rank.rank].local_size = 4096;
         comm_map[to_rank.rank].remote_size = 4096;
@@ -102,7 +114,8 @@ RankSyncSerialSkip::getDataSize() const {
     size_t count = 0;
     for ( comm_map_t::const_iterator it = comm_map.begin();
           it != comm_map.end(); ++it ) {
-        count += (it->second.squeue->getDataSize() + it->second.local_size);
+        count += (it->second.squeue->getDataSize() + it->second.local_size +
+                  it->second.dbuf.capacity() + (it->second.activity_vec.capacity() * sizeof(Activity*)));
     }
     return count;
 }
@@ -142,7 +155,7 @@ RankSyncSerialSkip::exchange(void)
             hdr->mode = 1;
             MPI_Isend(send_buffer, sizeof(SyncQueue::Header), MPI_BYTE,
                       i->first/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
-            i->second.remote_size = hdr->buffer_size;
+            i->second.remote_size = SyncQueue::growMessageSize(i->second.remote_size, hdr->buffer_size);
             tag = 2;
         }
         else {
@@ -156,6 +169,8 @@ RankSyncSerialSkip::exchange(void)
                   i->first, 1, MPI_COMM_WORLD, &rreqs[rreq_count++]);
     }
     
+    syncCount++;
+
     // Wait for all sends and recvs to complete
     Simulation* sim = Simulation::getSimulation();
     SimTime_t current_cycle = sim->getCurrentSimCycle();
@@ -176,22 +191,24 @@ RankSyncSerialSkip::exchange(void)
             // May need to resize the buffer
             if ( size > i->second.local_size ) {
                 delete[] i->second.rbuf;
-                i->second.rbuf = new char[size];
-                i->second.local_size = size;
+                i->second.local_size = SyncQueue::growMessageSize(i->second.local_size, size);
+                i->second.rbuf = new char[i->second.local_size];
             }
             MPI_Recv(i->second.rbuf, i->second.local_size, MPI_BYTE,
                      i->first, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
             buffer = i->second.rbuf;
         }
         
-        auto deserialStart = SST::Core::Profile::now();
+        auto decompressStart = SST::Core::Profile::now();
+        size_t payload_size;
+        char* payload = SyncQueue::getPayload(buffer, i->second.dbuf, payload_size);
+        decompressTime += SST::Core::Profile::getElapsed(decompressStart);
 
-        SST::Core::Serialization::serializer ser;
-        ser.start_unpacking(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
+        auto deserialStart = SST::Core::Profile::now();
 
-        std::vector<Activity*> activities;
-        activities.clear();
-        ser & activities;
+        std::vector<Activity*>& activities = i->second.activity_vec;
+        i->second.ser.start_unpacking(payload, payload_size);
+        i->second.ser & activities;
         
         deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
 
@@ -265,7 +282,7 @@ RankSyncSerialSkip::exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::atom
             // not big enough, send message that will tell remote side to get larger buffer
             hdr->mode = 1;
             MPI_Isend(send_buffer, sizeof(SyncQueue::Header), MPI_BYTE, i->first/*dest*/, tag, MPI_COMM_WORLD, &sreqs[sreq_count++]);
-            i->second.remote_size = hdr->buffer_size;
+            i->second.remote_size = SyncQueue::growMessageSize(i->second.remote_size, hdr->buffer_size);
             tag = 2;
         }
         else {
@@ -295,18 +312,19 @@ RankSyncSerialSkip::exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::atom
             // May need to resize the buffer
             if ( size > i->second.local_size ) {
                 delete[] i->second.rbuf;
-                i->second.rbuf = new char[size];
-                i->second.local_size = size;
+                i->second.local_size = SyncQueue::growMessageSize(i->second.local_size, size);
+                i->second.rbuf = new char[i->second.local_size];
             }
             MPI_Recv(i->second.rbuf, i->second.local_size, MPI_BYTE, i->first, 2, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
             buffer = i->second.rbuf;
         }
         
-        SST::Core::Serialization::serializer ser;
-        ser.start_unpacking(&buffer[sizeof(SyncQueue::Header)],size-sizeof(SyncQueue::Header));
-        
-        std::vector<Activity*> activities;
-        ser & activities;
+        size_t payload_size;
+        char* payload = SyncQueue::getPayload(buffer, i->second.dbuf, payload_size);
+
+        std::vector<Activity*>& activities = i->second.activity_vec;
+        i->second.ser.start_unpacking(payload, payload_size);
+        i->second.ser & activities;
         for ( unsigned int j = 0; j < activities.size(); j++ ) {
             
             Event* ev = static_cast<Event*>(activities[j]);
@@ -317,6 +335,7 @@ RankSyncSerialSkip::exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::atom
                 sendUntimedData_sync(link->second,ev);
             }
         }
+        activities.clear();
         
         
     }
@@ -15,8 +15,10 @@
 #include "sst/core/sst_types.h"
 #include <sst/core/syncManager.h>
 #include <sst/core/threadsafe.h>
+#include <sst/core/serialization/serializer.h>
 
 #include <map>
+#include <vector>
 
 namespace SST {
 
@@ -54,6 +56,11 @@ private:
     struct comm_pair {
         SyncQueue* squeue; // SyncQueue
         char* rbuf; // receive buffer
+        std::vector<char> dbuf; // decompression buffer
+        // Reused for every exchange so deserializing does not allocate
+        // once the buffers have reached their steady-state size
+        std::vector<Activity*> activity_vec;
+        SST::Core::Serialization::serializer ser;
         uint32_t local_size;
         uint32_t remote_size;
     };
@@ -67,6 +74,9 @@ private:
 
     double mpiWaitTime;
     double deserializeTime;
+    double decompressTime;
+    uint64_t compressThreshold;
+    uint64_t syncCount;
 
 };
 
@@ -0,0 +1,260 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sst/core/rankSyncShmem.h"
+
+#include "sst/core/serialization/serializer.h"
+
+#include "sst/core/event.h"
+#include "sst/core/exit.h"
+#include "sst/core/link.h"
+#include "sst/core/simulation.h"
+#include "sst/core/syncQueue.h"
+#include "sst/core/timeConverter.h"
+#include "sst/core/profile.h"
+#include "sst/core/interprocess/shmcomm.h"
+
+using SST::Core::Interprocess::ShmComm;
+
+namespace SST {
+
+// Static Data Members
+SimTime_t RankSyncShmem::myNextSyncTime = 0;
+
+
+RankSyncShmem::RankSyncShmem(TimeConverter* UNUSED(minPartTC)) :
+    NewRankSync(),
+    shmWaitTime(0.0),
+    deserializeTime(0.0),
+    compressThreshold(Simulation::getSyncCompressThreshold())
+{
+    max_period = Simulation::getSimulation()->getMinPartTC();
+    myNextSyncTime = max_period->getFactor();
+}
+
+RankSyncShmem::~RankSyncShmem()
+{
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        delete i->second.squeue;
+        delete[] i->second.rbuf;
+    }
+    comm_map.clear();
+
+    for (link_map_t::iterator i = link_map.begin() ; i != link_map.end() ; ++i) {
+        delete i->second;
+    }
+    link_map.clear();
+
+    if ( shmWaitTime > 0.0 || deserializeTime > 0.0 )
+        Output::getDefaultObject().verbose(CALL_INFO, 1, 0, "RankSyncShmem shmWait: %lg sec  deserializeWait:  %lg sec\n", shmWaitTime, deserializeTime);
+}
+
+ActivityQueue* RankSyncShmem::registerLink(const RankInfo& to_rank, const RankInfo& UNUSED(from_rank), LinkId_t link_id, Link* link)
+{
+    SyncQueue* queue;
+    if ( comm_map.count(to_rank.rank) == 0 ) {
+        comm_pair& cp = comm_map[to_rank.rank];
+        queue = cp.squeue = new SyncQueue(compressThreshold);
+        cp.rbuf = new char[4096];
+        cp.local_size = 4096;
+        cp.sbuf = NULL;
+        cp.send_size = cp.sent = 0;
+        cp.recv_size = cp.received = 0;
+    } else {
+        queue = comm_map[to_rank.rank].squeue;
+    }
+
+    link_map[link_id] = link;
+#ifdef __SST_DEBUG_EVENT_TRACKING__
+    link->setSendingComponentInfo("SYNC", "SYNC", "");
+#endif
+    return queue;
+}
+
+void
+RankSyncShmem::finalizeLinkConfigurations() {
+    for (link_map_t::iterator i = link_map.begin() ; i != link_map.end() ; ++i) {
+        finalizeConfiguration(i->second);
+    }
+}
+
+void
+RankSyncShmem::prepareForComplete() {
+    for (link_map_t::iterator i = link_map.begin() ; i != link_map.end() ; ++i) {
+        prepareForCompleteInt(i->second);
+    }
+}
+
+uint64_t
+RankSyncShmem::getDataSize() const {
+    size_t count = 0;
+    for ( comm_map_t::const_iterator it = comm_map.begin();
+          it != comm_map.end(); ++it ) {
+        count += (it->second.squeue->getDataSize() + it->second.local_size +
+                  it->second.dbuf.capacity() + (it->second.activity_vec.capacity() * sizeof(Activity*)));
+    }
+    return count;
+}
+
+void
+RankSyncShmem::execute(int thread)
+{
+    if ( thread == 0 ) {
+        exchange();
+    }
+}
+
+void
+RankSyncShmem::transfer()
+{
+    ShmComm* shm = ShmComm::get();
+
+    size_t pending = 0;
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        comm_pair& cp = i->second;
+        cp.sbuf = cp.squeue->getData();
+        cp.send_size = reinterpret_cast<SyncQueue::Header*>(cp.sbuf)->buffer_size;
+        cp.sent = 0;
+        // The header is read first to find out how much more is coming
+        cp.recv_size = sizeof(SyncQueue::Header);
+        cp.received = 0;
+        pending += 2;
+    }
+
+    // Messages can be larger than the rings, so keep both directions
+    // moving for every peer rather than finishing the sends first.
+    // Otherwise two ranks with full rings would wait on each other.
+    int loop_count = 0;
+    while ( pending ) {
+        bool progress = false;
+        for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+            comm_pair& cp = i->second;
+
+            if ( cp.sent < cp.send_size ) {
+                size_t n = shm->write(i->first, cp.sbuf + cp.sent, cp.send_size - cp.sent);
+                if ( n ) {
+                    progress = true;
+                    cp.sent += n;
+                    if ( cp.sent == cp.send_size ) pending--;
+                }
+            }
+
+            if ( cp.received < cp.recv_size ) {
+                size_t n = shm->read(i->first, cp.rbuf + cp.received, cp.recv_size - cp.received);
+                if ( n ) {
+                    progress = true;
+                    cp.received += n;
+                    if ( cp.recv_size == sizeof(SyncQueue::Header) && cp.received == cp.recv_size ) {
+                        uint32_t size = reinterpret_cast<SyncQueue::Header*>(cp.rbuf)->buffer_size;
+                        if ( size > cp.local_size ) {
+                            cp.local_size = SyncQueue::growMessageSize(cp.local_size, size);
+                            char* buf = new char[cp.local_size];
+                            ::memcpy(buf, cp.rbuf, sizeof(SyncQueue::Header));
+                            delete[] cp.rbuf;
+                            cp.rbuf = buf;
+                        }
+                        cp.recv_size = size;
+                    }
+                    if ( cp.received == cp.recv_size ) pending--;
+                }
+            }
+        }
+
+        if ( progress ) loop_count = 0;
+        else shm->pause(loop_count++);
+    }
+}
+
+void
+RankSyncShmem::exchange(void)
+{
+    auto waitStart = SST::Core::Profile::now();
+    transfer();
+    shmWaitTime += SST::Core::Profile::getElapsed(waitStart);
+
+    Simulation* sim = Simulation::getSimulation();
+    SimTime_t current_cycle = sim->getCurrentSimCycle();
+
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        auto deserialStart = SST::Core::Profile::now();
+
+        size_t payload_size;
+        char* payload = SyncQueue::getPayload(i->second.rbuf, i->second.dbuf, payload_size);
+
+        std::vector<Activity*>& activities = i->second.activity_vec;
+        i->second.ser.start_unpacking(payload, payload_size);
+        i->second.ser & activities;
+
+        deserializeTime += SST::Core::Profile::getElapsed(deserialStart);
+
+        for ( unsigned int j = 0; j < activities.size(); j++ ) {
+
+            Event* ev = static_cast<Event*>(activities[j]);
+            link_map_t::iterator link = link_map.find(ev->getLinkId());
+            if (link == link_map.end()) {
+                Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
+            } else {
+                // Need to figure out what the "delay" is for this event.
+                SimTime_t delay = ev->getDeliveryTime() - current_cycle;
+                link->second->send(delay,ev);
+            }
+        }
+
+        activities.clear();
+        i->second.squeue->clear();
+    }
+
+    // Check to see when the next event is scheduled, then do an
+    // all_reduce with min operator and set next sync time to be
+    // min + max_period.
+    SimTime_t input = Simulation::getLocalMinimumNextActivityTime();
+    SimTime_t min_time = ShmComm::get()->allreduce(input, ShmComm::MIN);
+
+    myNextSyncTime = min_time + max_period->getFactor();
+}
+
+void
+RankSyncShmem::exchangeLinkUntimedData(int thread, std::atomic<int>& msg_count)
+{
+    if ( thread != 0 ) {
+        return;
+    }
+
+    transfer();
+
+    for (comm_map_t::iterator i = comm_map.begin() ; i != comm_map.end() ; ++i) {
+        size_t payload_size;
+        char* payload = SyncQueue::getPayload(i->second.rbuf, i->second.dbuf, payload_size);
+
+        std::vector<Activity*>& activities = i->second.activity_vec;
+        i->second.ser.start_unpacking(payload, payload_size);
+        i->second.ser & activities;
+        for ( unsigned int j = 0; j < activities.size(); j++ ) {
+
+            Event* ev = static_cast<Event*>(activities[j]);
+            link_map_t::iterator link = link_map.find(ev->getLinkId());
+            if (link == link_map.end()) {
+                Simulation::getSimulationOutput().fatal(CALL_INFO,1,"Link not found in map!\n");
+            } else {
+                sendUntimedData_sync(link->second,ev);
+            }
+        }
+
+        activities.clear();
+        i->second.squeue->clear();
+    }
+
+    // Do an allreduce to see if there were any messages sent
+    msg_count = ShmComm::get()->allreduce<int>(msg_count, ShmComm::SUM);
+}
+
+} // namespace SST
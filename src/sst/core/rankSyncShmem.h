@@ -0,0 +1,94 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_RANKSYNCSHMEM_H
+#define SST_CORE_RANKSYNCSHMEM_H
+
+#include "sst/core/sst_types.h"
+#include <sst/core/syncManager.h>
+#include <sst/core/threadsafe.h>
+#include <sst/core/serialization/serializer.h>
+
+#include <map>
+#include <vector>
+
+namespace SST {
+
+class SyncQueue;
+class TimeConverter;
+
+/**
+ * RankSync for ranks that were launched as processes on a single node
+ * (--shm-ranks).  Sync buffers are passed through the shared-memory
+ * rings of Core::Interprocess::ShmComm rather than MPI.  As with
+ * RankSyncSerialSkip, only thread 0 of each rank takes part in the
+ * exchange.
+ */
+class RankSyncShmem : public NewRankSync {
+public:
+    /** Create a new Sync object which fires with a specified period */
+    RankSyncShmem(TimeConverter* minPartTC);
+    virtual ~RankSyncShmem();
+
+    /** Register a Link which this Sync Object is responsible for */
+    ActivityQueue* registerLink(const RankInfo& to_rank, const RankInfo& from_rank, LinkId_t link_id, Link* link) override;
+    void execute(int thread) override;
+
+    /** Cause an exchange of Untimed Data to occur */
+    void exchangeLinkUntimedData(int thread, std::atomic<int>& msg_count) override;
+    /** Finish link configuration */
+    void finalizeLinkConfigurations() override;
+    /** Prepare for the complete() stage */
+    void prepareForComplete() override;
+
+    SimTime_t getNextSyncTime() override { return myNextSyncTime; }
+
+    uint64_t getDataSize() const override;
+
+private:
+
+    static SimTime_t myNextSyncTime;
+
+    // Function that actually does the exchange during run
+    void exchange();
+    // Moves the send buffers into the rings and fills the receive
+    // buffers until every message has been completely transferred
+    void transfer();
+
+    struct comm_pair {
+        SyncQueue* squeue; // SyncQueue
+        char* sbuf; // send buffer for the current exchange
+        uint32_t send_size;
+        uint32_t sent;
+        char* rbuf; // receive buffer
+        std::vector<char> dbuf; // decompression buffer
+        std::vector<Activity*> activity_vec;
+        SST::Core::Serialization::serializer ser;
+        uint32_t local_size;
+        uint32_t recv_size;
+        uint32_t received;
+    };
+
+    typedef std::map<int, comm_pair > comm_map_t;
+    typedef std::map<LinkId_t, Link*> link_map_t;
+
+    comm_map_t comm_map;
+    link_map_t link_map;
+
+    double shmWaitTime;
+    double deserializeTime;
+    uint64_t compressThreshold;
+
+};
+
+} // namespace SST
+
+#endif // SST_CORE_RANKSYNCSHMEM_H
@@ -15,6 +15,7 @@
 #include <sst/core/serialization/serializer.h>
 #include <sst/core/warnmacros.h>
 #include <unordered_map>
+#include <type_traits>
 #include <typeinfo>
 #include <stdint.h>
 
@@ -118,6 +119,16 @@ public:
     virtual uint32_t
     cls_id() const = 0;
     virtual std::string serialization_name() const = 0;
+
+    /**
+       Bulk copy path for types declared with
+       ImplementTriviallySerializable.  Returns false if the object
+       has to be visited field by field through serialize_order().
+     */
+    virtual bool
+    serialize_trivially(serializer& UNUSED(ser)) {
+        return false;
+    }
     
     virtual ~serializable() { }
     
@@ -161,6 +172,11 @@ class serializable_type
     throw_exc(); \
     return ""; \
   } \
+  virtual bool \
+  serialize_trivially(SST::Core::Serialization::serializer& UNUSED(sst)) override { \
+    throw_exc(); \
+    return false; \
+  } \
   virtual const char* \
   cls_name() const override { \
     throw_exc(); \
@@ -185,6 +201,10 @@ class serializable_type
   serialization_name() const override { \
     return #obj; \
   } \
+  virtual bool \
+  serialize_trivially(SST::Core::Serialization::serializer& UNUSED(sst)) override { \
+    return false; \
+  } \
 private:\
   friend class SST::Core::Serialization::serializable_builder_impl<obj>;  \
   static bool                                                 \
@@ -196,6 +216,45 @@ private:\
  public: \
  ImplementSerializableDefaultConstructor(obj)
 
+/**
+   Use in place of ImplementSerializable for classes whose state is
+   entirely trivially copyable (no pointers that need to be followed,
+   no strings or containers).  The object is sent as its class id
+   followed by a raw copy of everything after the vtable pointer, so
+   serialize_order() is never called.  Only valid for classes with a
+   single chain of polymorphic bases.  Subclasses that use
+   ImplementSerializable revert to the field by field path.
+ */
+#define ImplementTriviallySerializable(obj) \
+ public: \
+  virtual const char* \
+  cls_name() const override { \
+    return #obj; \
+  } \
+  virtual uint32_t \
+  cls_id() const override { \
+    return SST::Core::Serialization::serializable_builder_impl<obj>::static_cls_id(); \
+  }           \
+  static obj* \
+  construct_deserialize_stub() { \
+    return new obj; \
+  } \
+  virtual std::string \
+  serialization_name() const override { \
+    return #obj; \
+  } \
+  virtual bool \
+  serialize_trivially(SST::Core::Serialization::serializer& sst) override { \
+    SST::Core::Serialization::pvt::serialize_body<obj>(this, sst); \
+    return true; \
+  } \
+private:\
+  friend class SST::Core::Serialization::serializable_builder_impl<obj>;  \
+  static bool                                                 \
+  you_forgot_to_add_ImplementSerializable_to_this_class() { \
+    return false; \
+  }
+
 
 class serializable_builder
 {
@@ -286,11 +345,37 @@ template<class T> const uint32_t serializable_builder_impl<T>::cls_id_
   = serializable_factory::add_builder(new serializable_builder_impl<T>,
        typeid(T).name());
 
-// Hold off on trivially_serializable for now, as it's not really safe
-// in the case of inheritance
-//
-// class trivially_serializable {
-// };
+namespace pvt {
+
+/**
+   Copies the body of a polymorphic object (everything after the
+   vtable pointer) to or from the serializer's buffer.  The vtable
+   pointer itself is left alone so that the object built by the
+   receiving side keeps the correct dynamic type.
+ */
+template <class T>
+void
+serialize_body(T* t, serializer& ser)
+{
+    static_assert(std::is_polymorphic<T>::value,
+                  "serialize_body requires a polymorphic type");
+    static const size_t offset = sizeof(void*);
+    static const size_t len = sizeof(T) - offset;
+    char* body = reinterpret_cast<char*>(t) + offset;
+    switch ( ser.mode() ) {
+    case serializer::SIZER:
+        ser.sizer().add(len);
+        break;
+    case serializer::PACK:
+        ::memcpy(ser.packer().next_str(len), body, len);
+        break;
+    case serializer::UNPACK:
+        ::memcpy(body, ser.unpacker().next_str(len), len);
+        break;
+    }
+}
+
+} // namespace pvt
 
 }  // namespace Serialization
 }  // namespace Core
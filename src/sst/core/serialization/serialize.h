@@ -18,6 +18,7 @@
 //DeclareDebugSlot(serialize);
 
 #include <iostream>
+#include <type_traits>
 #include <typeinfo>
 
 namespace SST {
@@ -46,6 +47,21 @@ public:
     }
 };
 
+namespace pvt {
+
+/**
+   True for types whose in-memory representation is also their
+   serialized representation, so that a run of them can be sized,
+   packed and unpacked as one block instead of element by element.
+   bool is excluded because it is serialized as an int.
+ */
+template <class T>
+struct is_block_copyable :
+    std::integral_constant<bool, (std::is_arithmetic<T>::value || std::is_enum<T>::value) &&
+                                 !std::is_same<T,bool>::value> {};
+
+}
+
 /**
    Version of serialize that works for fundamental types and enums.
  */
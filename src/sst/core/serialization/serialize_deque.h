@@ -22,10 +22,10 @@ namespace Serialization {
 template <class T>
 class serialize<std::deque<T> > {
   typedef std::deque<T> Deque;
- 
-public:
+
+  // Elements need their own serialize<> (or are bool)
   void
-  operator()(Deque& v, serializer& ser) {
+  serialize_deque(Deque& v, serializer& ser, std::false_type) {
       switch(ser.mode()) {
       case serializer::SIZER: {
           size_t size = v.size();
@@ -48,7 +48,7 @@ public:
       case serializer::UNPACK: {
           size_t size;
           ser.unpack(size);
-          for (int i=0; i < size; ++i){
+          for (size_t i=0; i < size; ++i){
               T t;
               serialize<T>()(t,ser);
               v.push_back(t);
@@ -57,6 +57,47 @@ public:
       }
       }
   }
+
+  // Elements are arithmetic or enums.  A deque is not contiguous, but
+  // the elements still occupy one block in the buffer, so claim it
+  // once and copy the elements straight in or out.
+  void
+  serialize_deque(Deque& v, serializer& ser, std::true_type) {
+      switch(ser.mode()) {
+      case serializer::SIZER: {
+          size_t size = v.size();
+          ser.size(size);
+          ser.sizer().add(size * sizeof(T));
+          break;
+      }
+      case serializer::PACK: {
+          size_t size = v.size();
+          ser.pack(size);
+          char* buf = ser.packer().next_str(size * sizeof(T));
+          for (auto it = v.begin(); it != v.end(); ++it, buf += sizeof(T)){
+              ::memcpy(buf, &(*it), sizeof(T));
+          }
+          break;
+      }
+      case serializer::UNPACK: {
+          size_t size;
+          ser.unpack(size);
+          const char* buf = ser.unpacker().next_str(size * sizeof(T));
+          size_t start = v.size();
+          v.resize(start + size);
+          for (auto it = v.begin() + start; it != v.end(); ++it, buf += sizeof(T)){
+              ::memcpy(&(*it), buf, sizeof(T));
+          }
+          break;
+      }
+      }
+  }
+
+public:
+  void
+  operator()(Deque& v, serializer& ser) {
+      serialize_deque(v, ser, pvt::is_block_copyable<T>());
+  }
 };
 
 }
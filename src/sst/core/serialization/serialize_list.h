@@ -22,9 +22,10 @@ namespace Serialization {
 template <class T>
 class serialize <std::list<T> > {
  typedef std::list<T> List; 
-public:
+
+ // Elements need their own serialize<> (or are bool)
  void
- operator()(List& v, serializer& ser) {
+ serialize_list(List& v, serializer& ser, std::false_type) {
   typedef typename List::iterator iterator;
   switch(ser.mode())
   {
@@ -51,7 +52,7 @@ public:
   case serializer::UNPACK: {
     size_t size;
     ser.unpack(size);
-    for (int i=0; i < size; ++i){
+    for (size_t i=0; i < size; ++i){
       T t;
       serialize<T>()(t, ser);
       v.push_back(t);
@@ -59,7 +60,50 @@ public:
     break;
   }
   }
-}
+ }
+
+ // Elements are arithmetic or enums: size in O(1) and move the
+ // elements through a single claimed block of the buffer
+ void
+ serialize_list(List& v, serializer& ser, std::true_type) {
+  typedef typename List::iterator iterator;
+  switch(ser.mode())
+  {
+  case serializer::SIZER: {
+    size_t size = v.size();
+    ser.size(size);
+    ser.sizer().add(size * sizeof(T));
+    break;
+  }
+  case serializer::PACK: {
+    size_t size = v.size();
+    ser.pack(size);
+    char* buf = ser.packer().next_str(size * sizeof(T));
+    iterator it, end = v.end();
+    for (it=v.begin(); it != end; ++it, buf += sizeof(T)){
+      ::memcpy(buf, &(*it), sizeof(T));
+    }
+    break;
+  }
+  case serializer::UNPACK: {
+    size_t size;
+    ser.unpack(size);
+    const char* buf = ser.unpacker().next_str(size * sizeof(T));
+    for (size_t i=0; i < size; ++i, buf += sizeof(T)){
+      T t;
+      ::memcpy(&t, buf, sizeof(T));
+      v.push_back(t);
+    }
+    break;
+  }
+  }
+ }
+
+public:
+ void
+ operator()(List& v, serializer& ser) {
+   serialize_list(v, ser, pvt::is_block_copyable<T>());
+ }
 
 };
 
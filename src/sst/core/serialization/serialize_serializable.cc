@@ -25,7 +25,7 @@ void
 size_serializable(serializable* s, serializer& ser){
   long dummy = 0;
   ser.size(dummy);
-  if (s) {
+  if (s && !s->serialize_trivially(ser)) {
     s->serialize_order(ser);
   }
 }
@@ -38,7 +38,7 @@ pack_serializable(serializable* s, serializer& ser){
     //   s->cls_id(), s->cls_name());
     long cls_id = s->cls_id();
     ser.pack(cls_id);
-    s->serialize_order(ser);
+    if ( !s->serialize_trivially(ser) ) s->serialize_order(ser);
   }
   else {
     // debug_printf(dbg::serialize, "null object");
@@ -58,7 +58,7 @@ unpack_serializable(serializable*& s, serializer& ser){
   else {
     // debug_printf(dbg::serialize, "unpacking class id %ld", cls_id);
       s = SST::Core::Serialization::serializable_factory::get_serializable(cls_id);
-    s->serialize_order(ser);
+    if ( !s->serialize_trivially(ser) ) s->serialize_order(ser);
     // debug_printf(dbg::serialize, "unpacked object %s", s->cls_name());
   }
 }
@@ -107,20 +107,13 @@ public:
     inline void operator()(T& t, serializer& ser){
         // T* tmp = &t;
         // serialize_intrusive_ptr(tmp, ser);
-        t.serialize_order(ser);
+        if ( !t.serialize_trivially(ser) ) t.serialize_order(ser);
     }
 };
 
-// Hold off on trivially_serializable for now, as it's not really safe
-// in the case of inheritance
-//
-// template <class T>
-// class serialize <T, typename std::enable_if<std::is_base_of<SST::Core::Serialization::trivially_serializable,T>::value>::type> {
-// public:
-//     inline void operator()(T& t, serializer& ser){
-//         ser.primitive(t);
-//     }
-// };
+// Types declared with ImplementTriviallySerializable are handled
+// through serializable::serialize_trivially(), which is safe under
+// inheritance because every ImplementSerializable overrides it.
 
 
 } 
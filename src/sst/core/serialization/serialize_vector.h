@@ -22,6 +22,21 @@ namespace Serialization {
 template <class T>
 class serialize<std::vector<T> > {
   typedef std::vector<T> Vector; 
+
+  // Elements need their own serialize<> (or are bool)
+  void
+  serialize_elements(Vector& v, serializer& ser, std::false_type) {
+    for (size_t i=0; i < v.size(); ++i){
+      serialize<T>()(v[i], ser);
+    }
+  }
+
+  // Elements are arithmetic or enums, so copy the storage in one block
+  void
+  serialize_elements(Vector& v, serializer& ser, std::true_type) {
+    ser.raw(v.data(), v.size() * sizeof(T));
+  }
+
  public:
   void
   operator()(Vector& v, serializer& ser) {
@@ -44,10 +59,8 @@ class serialize<std::vector<T> > {
       break;
     }
     }
-  
-    for (size_t i=0; i < v.size(); ++i){
-      serialize<T>()(v[i], ser);
-    }
+
+    serialize_elements(v, ser, pvt::is_block_copyable<T>());
   }
   
 };
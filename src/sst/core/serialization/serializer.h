@@ -136,6 +136,27 @@ public:
         }
     }
 
+    /**
+       Size, pack or unpack size bytes starting at buf as a single
+       block, with no length prefix.  The caller is responsible for
+       making sure buf points to at least size bytes on unpack.
+     */
+    void
+    raw(void* buf, size_t size) {
+        if ( size == 0 ) return;
+        switch (mode_) {
+        case SIZER:
+            sizer_.add(size);
+            break;
+        case PACK:
+            ::memcpy(packer_.next_str(size), buf, size);
+            break;
+        case UNPACK:
+            ::memcpy(buf, unpacker_.next_str(size), size);
+            break;
+        }
+    }
+
     template <typename T, typename Int>
     void
     binary(T*& buffer, Int& size){
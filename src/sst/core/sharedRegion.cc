@@ -26,6 +26,7 @@
 #include <sst/core/simulation.h>
 #include <sst/core/sharedRegionImpl.h>
 #include <sst/core/objectComms.h>
+#include <sst/core/interprocess/shmcomm.h>
 
 
 namespace SST {
@@ -275,10 +276,19 @@ void SharedRegionManagerImpl::updateState(bool finalize)
 {
     std::lock_guard<std::mutex> lock(mtx);
     
+    if ( Simulation::getSimulation()->getNumRanks().rank > 1 && Core::Interprocess::ShmComm::active() ) {
+        for ( auto &&rii = regions.begin() ; rii != regions.end() ; ++rii ) {
+            if ( rii->second.shouldMerge() ) {
+                Simulation::getSimulationOutput().fatal(CALL_INFO, 1,
+                        "SharedRegion '%s' needs to be merged across ranks, which is not supported with --shm-ranks\n",
+                        rii->first.c_str());
+            }
+        }
+    }
 #ifdef SST_CONFIG_HAVE_MPI
     // Exchange data between ranks
     int myRank = Simulation::getSimulation()->getRank().rank;
-    if ( Simulation::getSimulation()->getNumRanks().rank > 1 ) {
+    if ( Simulation::getSimulation()->getNumRanks().rank > 1 && !Core::Interprocess::ShmComm::active() ) {
 
         std::map<std::string, CommInfo_t> commInfo;
 
@@ -18,8 +18,10 @@
 
 //#include <sst/core/archive.h>
 #include <sst/core/clock.h>
+#include <sst/core/componentProfile.h>
 #include <sst/core/config.h>
 #include <sst/core/configGraph.h>
+#include <sst/core/cputimer.h>
 #include <sst/core/heartbeat.h>
 //#include <sst/core/event.h>
 #include <sst/core/exit.h>
@@ -29,6 +31,7 @@
 #include <sst/core/linkPair.h>
 #include <sst/core/sharedRegionImpl.h>
 #include <sst/core/output.h>
+#include <sst/core/startupProfiler.h>
 #include <sst/core/stopAction.h>
 #include <sst/core/stringize.h>
 #include <sst/core/syncBase.h>
@@ -176,7 +179,13 @@ Component*
 Simulation::createComponent( ComponentId_t id, std::string &name, 
                              Params &params )
 {
-    return factory->CreateComponent(id, name, params);
+    Core::StartupProfiler* profiler = Core::StartupProfiler::get();
+    if ( profiler == NULL ) return factory->CreateComponent(id, name, params);
+
+    double start = sst_get_cpu_time();
+    Component* comp = factory->CreateComponent(id, name, params);
+    profiler->addComponentTime(name, sst_get_cpu_time() - start);
+    return comp;
 }
 
 
@@ -225,8 +234,8 @@ Simulation::processGraphInfo( ConfigGraph& graph, const RankInfo& UNUSED(myRank)
     int cross_thread_links = 0;
     if ( num_ranks.thread > 1 ) {
         // Need to determine the lookahead for the thread synchronization
-        ConfigComponentMap_t comps = graph.getComponentMap();
-        ConfigLinkMap_t links = graph.getLinkMap();
+        ConfigComponentMap_t& comps = graph.getComponentMap();
+        ConfigLinkMap_t& links = graph.getLinkMap();
         // Find the minimum latency across a partition
         for ( auto iter = links.begin(); iter != links.end(); ++iter ) {
             ConfigLink &clink = *iter;
@@ -303,6 +312,8 @@ int Simulation::performWireUp( ConfigGraph& graph, const RankInfo& myRank, SimTi
         }
     }
 
+    Core::ComponentProfile* profile = Core::ComponentProfile::get();
+
     // We will go through all the links and create LinkPairs for each
     // link.  We will also create a LinkMap for each component and put
     // them into a map with ComponentID as the key.
@@ -322,6 +333,7 @@ int Simulation::performWireUp( ConfigGraph& graph, const RankInfo& myRank, SimTi
         else if ( rank[0] == rank[1] ) {
             // Create a LinkPair to represent this link
             LinkPair lp(clink.id);
+            if ( profile ) profile->addLink(clink.id, clink.name);
 
             lp.getLeft()->setLatency(clink.latency[0]);
             lp.getRight()->setLatency(clink.latency[1]);
@@ -357,6 +369,7 @@ int Simulation::performWireUp( ConfigGraph& graph, const RankInfo& myRank, SimTi
 
             // Create a LinkPair to represent this link
             LinkPair lp(clink.id);
+            if ( profile ) profile->addLink(clink.id, clink.name);
 
             lp.getLeft()->setLatency(clink.latency[local]);
             lp.getRight()->setLatency(0);
@@ -406,10 +419,8 @@ int Simulation::performWireUp( ConfigGraph& graph, const RankInfo& myRank, SimTi
             cinfo->setComponent(tmp);
         }
     } // end for all vertex
-    // Done with vertices, delete them;
-    /*  TODO:  THREADING:  Clear only once everybody is done.
-    graph.comps.clear();
-    */
+    // The graph is shared by all threads on the rank, so it is freed by
+    // main once every thread has finished wiring up
     wireUpFinished = true;
     // std::cout << "Done with performWireUp" << std::endl;
     return 0;
@@ -420,7 +431,9 @@ void Simulation::initialize() {
     initBarrier.wait();
     if ( my_rank.thread == 0 ) sharedRegionManager->updateState(false);
 
+    Core::StartupProfiler* profiler = Core::StartupProfiler::get();
     do {
+        double round_start = profiler ? sst_get_cpu_time() : 0.0;
         initBarrier.wait();
         if ( my_rank.thread == 0 ) untimed_msg_count = 0;
         initBarrier.wait();
@@ -438,6 +451,7 @@ void Simulation::initialize() {
         if ( my_rank.thread == 0 ) sharedRegionManager->updateState(false);
 
         untimed_phase++;
+        if ( profiler ) profiler->addInitRound(sst_get_cpu_time() - round_start);
     } while ( !done);
 
     // Walk through all the links and call finalizeConfiguration
@@ -755,6 +769,18 @@ Cycle_t Simulation::getNextClockCycle(TimeConverter* tc, int priority) {
     return clockMap[ mapKey ]->getNextCycle();
 }
 
+Clock::GroupBase* Simulation::getClockGroup(TimeConverter* tc, const std::type_info& type, int priority) {
+    clockMap_t::key_type mapKey = std::make_pair(tc->getFactor(), priority);
+    clockMap_t::iterator it = clockMap.find( mapKey );
+    if ( it == clockMap.end() ) return NULL;
+    return it->second->getGroup( type );
+}
+
+void Simulation::registerClockGroup(TimeConverter* tc, const std::type_info& type, Clock::GroupBase* group, int priority) {
+    registerClock(tc, group, priority);
+    clockMap[ std::make_pair(tc->getFactor(), priority) ]->addGroup( type, group );
+}
+
 void Simulation::unregisterClock(TimeConverter *tc, Clock::HandlerBase* handler, int priority) {
     clockMap_t::key_type mapKey = std::make_pair(tc->getFactor(), priority);
     if ( clockMap.find( mapKey ) != clockMap.end() ) {
@@ -856,6 +882,7 @@ Core::ThreadSafe::Barrier Simulation::finishBarrier;
 std::mutex Simulation::simulationMutex;
 TimeConverter* Simulation::minPartTC = NULL;
 SimTime_t Simulation::minPart;
+uint64_t Simulation::syncCompressThreshold = 0;
 
 
 
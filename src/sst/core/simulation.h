@@ -154,6 +154,10 @@ public:
     Cycle_t reregisterClock(TimeConverter *tc, Clock::HandlerBase* handler, int priority);
     /** Returns the next Cycle that the TImeConverter would fire. */
     Cycle_t getNextClockCycle(TimeConverter* tc, int priority = CLOCKPRIORITY);
+    /** Returns the clock group for components of type on this clock, or NULL if there is none */
+    Clock::GroupBase* getClockGroup(TimeConverter* tc, const std::type_info& type, int priority);
+    /** Register a new clock group for components of type.  The clock takes ownership of group. */
+    void registerClockGroup(TimeConverter* tc, const std::type_info& type, Clock::GroupBase* group, int priority);
 
     /** Register a OneShot event to be called after a time delay
         Note: OneShot cannot be canceled, and will always callback after
@@ -171,6 +175,8 @@ public:
     const std::vector<SimTime_t>& getInterThreadLatencies() const { return interThreadLatencies; }
     SimTime_t getInterThreadMinLatency() const { return interThreadMinLatency; }
     static TimeConverter* getMinPartTC() { return minPartTC; }
+    /** Size above which cross-rank sync buffers are compressed (0 = never) */
+    static uint64_t getSyncCompressThreshold() { return syncCompressThreshold; }
 
     /** Return the TimeLord associated with this Simulation */
     static TimeLord* getTimeLord(void) { return &timeLord; }
@@ -337,6 +343,7 @@ private:
     Activity*        current_activity;
     static SimTime_t minPart;
     static TimeConverter*   minPartTC;
+    static uint64_t  syncCompressThreshold;
     std::vector<SimTime_t> interThreadLatencies;
     SimTime_t        interThreadMinLatency;
     SyncManager*     syncManager;
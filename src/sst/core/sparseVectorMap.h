@@ -17,6 +17,8 @@
 #include "sst/core/sst_types.h"
 #include <sst/core/serialization/serializable.h>
 
+#include <algorithm>
+#include <unordered_map>
 #include <vector>
 
 namespace SST {
@@ -28,6 +30,38 @@ private:
     friend class SST::Core::Serialization::serialize<SparseVectorMap<keyT,classT> >;
     
     std::vector<classT> data;
+
+    // State for a bulk load (see beginBulkLoad())
+    bool bulk_load = false;
+    bool indexed = false;
+    bool sorted = true;
+    std::unordered_map<keyT, size_t> index;
+
+    void bulk_append(const classT& val)
+    {
+        if ( indexed && !index.insert(std::make_pair(val.key(), data.size())).second ) {
+            return;  // already in the map
+        }
+        if ( data.size() != 0 && !(data[data.size()-1].key() < val.key()) ) sorted = false;
+        data.push_back(val);
+    }
+
+    int find_index(keyT id) const
+    {
+        if ( bulk_load ) {
+            if ( indexed ) {
+                auto it = index.find(id);
+                return it == index.end() ? -1 : it->second;
+            }
+            if ( !sorted ) {
+                for ( size_t i = 0; i < data.size(); i++ ) {
+                    if ( id == data[i].key() ) return i;
+                }
+                return -1;
+            }
+        }
+        return binary_search_find(id);
+    }
     int binary_search_insert(keyT id) const
     {
         // For insert, we've found the right place when id < n && id >
@@ -91,6 +125,11 @@ public:
     // with insert() once things stabilize.
     void push_back(const classT& val)
     {
+        if ( bulk_load ) {
+            bulk_append(val);
+            return;
+        }
+
         // First look to see if it goes on the end.  If not, then find
         // where it goes.
         if ( data.size() == 0 ) {
@@ -108,6 +147,11 @@ public:
     
     void insert(const classT& val)
     {
+        if ( bulk_load ) {
+            bulk_append(val);
+            return;
+        }
+
         int index = binary_search_insert(val.key());
         if ( index == -1 ) return;  // already in the map
         iterator it = data.begin();
@@ -123,13 +167,13 @@ public:
 
     bool contains(keyT id) const
     {
-        if ( binary_search_find(id) == -1 ) return false;
+        if ( find_index(id) == -1 ) return false;
         return true;
     }
     
     classT& operator[] (keyT id)
     {
-        int index = binary_search_find(id);
+        int index = find_index(id);
         if ( index == -1 ) {
             // Need to error out
         }
@@ -138,16 +182,63 @@ public:
     
     const classT& operator[] (keyT id) const
     {
-        int index = binary_search_find(id);
+        int index = find_index(id);
         if ( index == -1 ) {
             // Need to error out
         }
         return data[index];
     }
     
-    void clear() { data.clear(); }
+    void clear()
+    {
+        data.clear();
+        index.clear();
+        sorted = true;
+    }
     size_t size() { return data.size(); }
 
+    /**
+     * Start a bulk load.  Until finalizeBulkLoad() is called, insert()
+     * and push_back() append to the end whatever order the keys arrive
+     * in, and iteration is in insertion order.
+     *
+     * @param use_index - keep a hash index of the keys, so that lookups
+     *   are O(1) and duplicate keys are ignored as they are inserted.
+     *   Without it, lookups search linearly once the keys arrive out of
+     *   order, and duplicates are removed by finalizeBulkLoad().
+     */
+    void beginBulkLoad(bool use_index = true)
+    {
+        bulk_load = true;
+        indexed = use_index;
+        sorted = true;
+        for ( size_t i = 0; i < data.size(); i++ ) {
+            if ( indexed ) index[data[i].key()] = i;
+        }
+    }
+
+    /**
+     * End a bulk load: sort the map into key order, keeping the first
+     * of any duplicate keys, and drop the index.
+     */
+    void finalizeBulkLoad()
+    {
+        if ( !bulk_load ) return;
+        if ( !sorted ) {
+            std::stable_sort(data.begin(), data.end(),
+                             [](const classT& a, const classT& b) { return a.key() < b.key(); });
+            data.erase(std::unique(data.begin(), data.end(),
+                                   [](const classT& a, const classT& b) { return a.key() == b.key(); }),
+                       data.end());
+        }
+        bulk_load = false;
+        indexed = false;
+        sorted = true;
+        std::unordered_map<keyT, size_t>().swap(index);
+    }
+
+    bool inBulkLoad() const { return bulk_load; }
+
 };
 
 template <typename keyT>
@@ -156,6 +247,8 @@ private:
     friend class SST::Core::Serialization::serialize<SparseVectorMap<keyT,keyT> >;
 
     std::vector<keyT> data;
+    bool bulk_load = false;
+
     int binary_search_insert(keyT id) const
     {
         // For insert, we've found the right place when id < n && id >
@@ -208,6 +301,18 @@ private:
         return -1;
     }
 
+    int find_index(keyT id) const
+    {
+        // The keys are not sorted until the bulk load is finalized
+        if ( bulk_load ) {
+            for ( size_t i = 0; i < data.size(); i++ ) {
+                if ( id == data[i] ) return i;
+            }
+            return -1;
+        }
+        return binary_search_find(id);
+    }
+
     friend class ConfigGraph;
     
 public:
@@ -219,6 +324,11 @@ public:
     // with insert() once things stabilize.
     void push_back(const keyT& val)
     {
+        if ( bulk_load ) {
+            data.push_back(val);
+            return;
+        }
+
         // First look to see if it goes on the end.  If not, then find
         // where it goes.
         if ( data.size() == 0 ) {
@@ -236,6 +346,11 @@ public:
     
     void insert(const keyT& val)
     {
+        if ( bulk_load ) {
+            data.push_back(val);
+            return;
+        }
+
         int index = binary_search_insert(val);
         if ( index == -1 ) return;  // already in the map
         iterator it = data.begin();
@@ -251,13 +366,13 @@ public:
 
     bool contains(keyT id)
     {
-        if ( binary_search_find(id) == -1 ) return false;
+        if ( find_index(id) == -1 ) return false;
         return true;
     }
     
     keyT& operator[] (keyT id)
     {
-        int index = binary_search_find(id);
+        int index = find_index(id);
         if ( index == -1 ) {
             // Need to error out
         }
@@ -266,7 +381,7 @@ public:
     
     const keyT& operator[] (keyT id) const
     {
-        int index = binary_search_find(id);
+        int index = find_index(id);
         if ( index == -1 ) {
             // Need to error out
         }
@@ -275,6 +390,21 @@ public:
     
     void clear() { data.clear(); }
     size_t size() { return data.size(); }
+
+    /**
+     * Start a bulk load.  Until finalizeBulkLoad() is called, insert()
+     * and push_back() simply append, and lookups search linearly.
+     */
+    void beginBulkLoad() { bulk_load = true; }
+
+    /** End a bulk load: sort the keys and remove duplicates */
+    void finalizeBulkLoad()
+    {
+        if ( !bulk_load ) return;
+        std::sort(data.begin(), data.end());
+        data.erase(std::unique(data.begin(), data.end()), data.end());
+        bulk_load = false;
+    }
     
 };
 
@@ -291,6 +421,8 @@ class serialize <SST::SparseVectorMap<keyT,classT>> {
 public:
     void
         operator()(SST::SparseVectorMap<keyT,classT>& v, SST::Core::Serialization::serializer& ser) {
+        // Maps are always transferred in key order
+        v.finalizeBulkLoad();
         ser & v.data;
     }
 };
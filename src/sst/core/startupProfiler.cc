@@ -0,0 +1,233 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/startupProfiler.h>
+
+#include <sst/core/cputimer.h>
+#include <sst/core/memuse.h>
+#include <sst/core/output.h>
+#include <sst/core/warnmacros.h>
+#include <sst/core/interprocess/shmcomm.h>
+
+#ifdef SST_CONFIG_HAVE_MPI
+DISABLE_WARN_MISSING_OVERRIDE
+#include <mpi.h>
+REENABLE_WARNING
+#endif
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+namespace SST {
+namespace Core {
+
+StartupProfiler* StartupProfiler::instance = NULL;
+thread_local uint32_t StartupProfiler::current_thread = 0;
+
+
+StartupProfiler::Phase::Phase(const std::string& name) :
+    name(name), start(0), start_rss(0), active(instance != NULL)
+{
+    if ( active ) {
+        start_rss = localMemSize();
+        start = sst_get_cpu_time();
+    }
+}
+
+void
+StartupProfiler::Phase::end()
+{
+    if ( !active ) return;
+    active = false;
+    double wall = sst_get_cpu_time() - start;
+    instance->addPhase(name, start, wall, (int64_t)localMemSize() - (int64_t)start_rss);
+}
+
+
+StartupProfiler::StartupProfiler(const std::string& file, const RankInfo& rank, const RankInfo& world_size) :
+    file(file), rank(rank), world_size(world_size), start_time(sst_get_cpu_time()), threads(world_size.thread)
+{
+}
+
+void
+StartupProfiler::init(const std::string& file, const RankInfo& rank, const RankInfo& world_size)
+{
+    if ( instance != NULL ) return;
+    instance = new StartupProfiler(file, rank, world_size);
+}
+
+void
+StartupProfiler::setRank(uint32_t new_rank)
+{
+    if ( new_rank == rank.rank ) return;
+    rank.rank = new_rank;
+    threads.clear();
+    threads.resize(world_size.thread);
+}
+
+void
+StartupProfiler::addPhase(const std::string& name, double start, double wall, int64_t rss_delta)
+{
+    PhaseRecord record = { name, start - start_time, wall, rss_delta };
+    thread().phases.push_back(record);
+}
+
+void
+StartupProfiler::addComponentTime(const std::string& type, double seconds)
+{
+    TypeRecord& record = thread().types[type];
+    record.count++;
+    record.total += seconds;
+    if ( seconds > record.max ) record.max = seconds;
+}
+
+void
+StartupProfiler::addInitRound(double seconds)
+{
+    thread().init_rounds.push_back(seconds);
+}
+
+
+static std::string jsonString(const std::string& str)
+{
+    std::string out = "\"";
+    for ( char c : str ) {
+        if ( c == '"' || c == '\\' ) out += '\\';
+        if ( (unsigned char)c < 0x20 ) {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+            continue;
+        }
+        out += c;
+    }
+    return out + "\"";
+}
+
+std::string
+StartupProfiler::rankReport() const
+{
+    std::ostringstream os;
+    os.precision(9);
+    os << "    {\n";
+    os << "      \"rank\" : " << rank.rank << ",\n";
+    os << "      \"threads\" : [\n";
+    for ( size_t t = 0; t < threads.size(); t++ ) {
+        const ThreadRecord& thr = threads[t];
+        os << "        {\n";
+        os << "          \"thread\" : " << t << ",\n";
+
+        os << "          \"phases\" : [";
+        for ( size_t i = 0; i < thr.phases.size(); i++ ) {
+            const PhaseRecord& p = thr.phases[i];
+            os << (i ? ",\n" : "\n");
+            os << "            { \"name\" : " << jsonString(p.name) << ", \"start\" : " << p.start
+               << ", \"wall\" : " << p.wall << ", \"rss_delta_kb\" : " << p.rss_delta << " }";
+        }
+        os << "\n          ],\n";
+
+        os << "          \"component_types\" : [";
+        bool first = true;
+        for ( auto& type : thr.types ) {
+            os << (first ? "\n" : ",\n");
+            first = false;
+            os << "            { \"type\" : " << jsonString(type.first) << ", \"count\" : " << type.second.count
+               << ", \"total\" : " << type.second.total << ", \"max\" : " << type.second.max << " }";
+        }
+        os << "\n          ],\n";
+
+        os << "          \"init_rounds\" : [";
+        for ( size_t i = 0; i < thr.init_rounds.size(); i++ ) {
+            os << (i ? ", " : " ") << thr.init_rounds[i];
+        }
+        os << " ]\n";
+        os << "        }" << (t + 1 < threads.size() ? "," : "") << "\n";
+    }
+    os << "      ]\n";
+    os << "    }";
+    return os.str();
+}
+
+static void rankBarrier()
+{
+    if ( Interprocess::ShmComm::active() ) {
+        Interprocess::ShmComm::get()->barrier();
+    }
+#ifdef SST_CONFIG_HAVE_MPI
+    else {
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+#endif
+}
+
+void
+StartupProfiler::write()
+{
+    Output& out = Output::getDefaultObject();
+
+    // Each rank writes its part next to the report, then rank 0
+    // stitches them together.  Every rank can already reach the
+    // output directory.
+    std::vector<std::string> reports;
+    if ( world_size.rank == 1 ) {
+        reports.push_back(rankReport());
+    }
+    else {
+        std::string part = file + ".rank" + std::to_string(rank.rank);
+        {
+            std::ofstream os(part.c_str());
+            os << rankReport();
+            if ( !os ) {
+                out.fatal(CALL_INFO, 1, "Unable to write startup profile %s: %s\n", part.c_str(), strerror(errno));
+            }
+        }
+        rankBarrier();
+        if ( rank.rank != 0 ) return;
+
+        for ( uint32_t r = 0; r < world_size.rank; r++ ) {
+            std::string name = file + ".rank" + std::to_string(r);
+            std::ifstream is(name.c_str());
+            if ( !is ) {
+                out.fatal(CALL_INFO, 1, "Unable to read startup profile %s: %s\n", name.c_str(), strerror(errno));
+            }
+            std::ostringstream contents;
+            contents << is.rdbuf();
+            reports.push_back(contents.str());
+            unlink(name.c_str());
+        }
+    }
+
+    FILE* fp = fopen(file.c_str(), "w");
+    if ( fp == NULL ) {
+        out.fatal(CALL_INFO, 1, "Unable to open startup profile %s for writing: %s\n", file.c_str(), strerror(errno));
+    }
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"num_ranks\" : %" PRIu32 ",\n", world_size.rank);
+    fprintf(fp, "  \"num_threads\" : %" PRIu32 ",\n", world_size.thread);
+    fprintf(fp, "  \"ranks\" : [\n");
+    for ( size_t r = 0; r < reports.size(); r++ ) {
+        fprintf(fp, "%s%s\n", reports[r].c_str(), r + 1 < reports.size() ? "," : "");
+    }
+    fprintf(fp, "  ]\n");
+    fprintf(fp, "}\n");
+    fclose(fp);
+
+    out.verbose(CALL_INFO, 1, 0, "# Wrote startup profile to %s\n", file.c_str());
+}
+
+}
+}
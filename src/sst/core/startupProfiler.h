@@ -0,0 +1,119 @@
+// Copyright 2009-2018 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2018, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_CORE_STARTUPPROFILER_H
+#define SST_CORE_STARTUPPROFILER_H
+
+#include <sst/core/sst_types.h>
+#include <sst/core/rankInfo.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Core {
+
+/**
+ * Records the wall time and change in resident memory of each phase of
+ * startup (model, partitioning, graph distribution, library loading,
+ * wireup, init rounds, setup), along with the time spent in component
+ * constructors for each component type.  Enabled with
+ * --profile-startup; when it is off, get() returns NULL and Phase does
+ * nothing.
+ *
+ * Each thread records into its own slot, chosen by setThread(), so no
+ * locking is needed.  Memory deltas are for the whole process, so
+ * phases that overlap on different threads see each other's
+ * allocations.
+ */
+class StartupProfiler {
+
+public:
+    /** Times a phase from construction until end() or destruction */
+    class Phase {
+    public:
+        Phase(const std::string& name);
+        ~Phase() { end(); }
+
+        void end();
+
+    private:
+        std::string name;
+        double start;
+        uint64_t start_rss;
+        bool active;
+    };
+
+    /** Turn on profiling.  Called by main() once the command line is parsed. */
+    static void init(const std::string& file, const RankInfo& rank, const RankInfo& world_size);
+
+    /** Returns the profiler, or NULL if profiling is off */
+    static StartupProfiler* get() { return instance; }
+
+    /** Set the thread that this OS thread records into */
+    static void setThread(uint32_t thread) { current_thread = thread; }
+
+    /**
+     * Called in a rank forked from rank 0.  The phases recorded before
+     * the fork belong to rank 0, so they are dropped.
+     */
+    void setRank(uint32_t rank);
+
+    void addPhase(const std::string& name, double start, double wall, int64_t rss_delta);
+    void addComponentTime(const std::string& type, double seconds);
+    void addInitRound(double seconds);
+
+    /**
+     * Write the report.  Every rank must call this; rank 0 combines the
+     * results into the report file.
+     */
+    void write();
+
+private:
+    struct PhaseRecord {
+        std::string name;
+        double start;
+        double wall;
+        int64_t rss_delta;
+    };
+
+    struct TypeRecord {
+        uint64_t count;
+        double total;
+        double max;
+    };
+
+    struct ThreadRecord {
+        std::vector<PhaseRecord> phases;
+        std::map<std::string, TypeRecord> types;
+        std::vector<double> init_rounds;
+    };
+
+    StartupProfiler(const std::string& file, const RankInfo& rank, const RankInfo& world_size);
+
+    ThreadRecord& thread() { return threads[current_thread]; }
+    std::string rankReport() const;
+
+    static StartupProfiler* instance;
+    static thread_local uint32_t current_thread;
+
+    std::string file;
+    RankInfo rank;
+    RankInfo world_size;
+    double start_time;
+    std::vector<ThreadRecord> threads;
+};
+
+}
+}
+
+#endif // SST_CORE_STARTUPPROFILER_H
@@ -23,7 +23,9 @@
 #include "sst/core/rankSyncSerialSkip.h"
 #include "sst/core/rankSyncParallelSkip.h"
 #include "sst/core/rankSyncParallelSkip.h"
+#include "sst/core/rankSyncShmem.h"
 #include "sst/core/threadSyncSimpleSkip.h"
+#include "sst/core/interprocess/shmcomm.h"
 
 #ifdef SST_CONFIG_HAVE_MPI
 DISABLE_WARN_MISSING_OVERRIDE
@@ -53,16 +55,21 @@ public:
     ActivityQueue* registerLink(const RankInfo& UNUSED(to_rank), const RankInfo& UNUSED(from_rank), LinkId_t UNUSED(link_id), Link* UNUSED(link)) override { return NULL; }
 
     void execute(int UNUSED(thread)) override {}
-    void exchangeLinkUntimedData(int UNUSED_WO_MPI(thread), std::atomic<int>& UNUSED_WO_MPI(msg_count)) override {
+    void exchangeLinkUntimedData(int thread, std::atomic<int>& msg_count) override {
         // Even though there are no links crossing ranks, we still
         // need to make sure every rank does the same number of init
         // cycles so the shared memory regions initialization works.
         
-#ifdef SST_CONFIG_HAVE_MPI
         if ( thread != 0 ) {
             return;
         }
+
+        if ( Core::Interprocess::ShmComm::active() ) {
+            msg_count = Core::Interprocess::ShmComm::get()->allreduce<int>(msg_count, Core::Interprocess::ShmComm::SUM);
+            return;
+        }
         
+#ifdef SST_CONFIG_HAVE_MPI
         // Do an allreduce to see if there were any messages sent
         int input = msg_count;
 
@@ -116,7 +123,10 @@ SyncManager::SyncManager(const RankInfo& rank, const RankInfo& num_ranks, TimeCo
         for ( auto &b : RankExecBarrier ) { b.resize(num_ranks.thread); }
         for ( auto &b : LinkUntimedBarrier ) { b.resize(num_ranks.thread); }
         if ( min_part != MAX_SIMTIME_T ) {
-            if ( num_ranks.thread == 1 ) {
+            if ( Core::Interprocess::ShmComm::active() ) {
+                rankSync = new RankSyncShmem(minPartTC);
+            }
+            else if ( num_ranks.thread == 1 ) {
                 rankSync = new RankSyncSerialSkip(/*num_ranks,*/ minPartTC);
             }
             else {
@@ -17,6 +17,8 @@
 #include <sst/core/event.h>
 
 #include <sst/core/simulation.h>
+#include <sst/core/profile.h>
+#include <sst/core/compress/lzblock.h>
 
 
 namespace SST {
@@ -24,13 +26,16 @@ namespace SST {
 using namespace Core::ThreadSafe;
 using namespace Core::Serialization;
 
-SyncQueue::SyncQueue() :
-    ActivityQueue(), buffer(NULL), buf_size(0)
+SyncQueue::SyncQueue(uint64_t compress_threshold) :
+    ActivityQueue(), buffer(NULL), buf_size(0), cbuffer(NULL), cbuf_size(0),
+    compress_threshold(compress_threshold), compress_saved(0), compress_time(0.0)
 {
 }
 
 SyncQueue::~SyncQueue()
 {
+    delete[] buffer;
+    delete[] cbuffer;
 }
     
 bool
@@ -93,12 +98,18 @@ SyncQueue::getData()
 
     size_t size = ser.size();
 
+    // The header, and the ranks' buffer size exchange, carry 32 bit sizes
+    if ( size + sizeof(SyncQueue::Header) > UINT32_MAX ) {
+        Simulation::getSimulationOutput().fatal(CALL_INFO, 1, "Sync buffer of %zu bytes is larger than the 4GB a sync can carry\n",
+                                                size + sizeof(SyncQueue::Header));
+    }
+
     if ( buf_size < ( size + sizeof(SyncQueue::Header) ) ) {
         if ( buffer != NULL ) {
             delete[] buffer;
         }
         
-        buf_size = size + sizeof(SyncQueue::Header);
+        buf_size = growBufferSize(buf_size, size + sizeof(SyncQueue::Header));
         buffer = new char[buf_size];
     }
         
@@ -112,10 +123,57 @@ SyncQueue::getData()
     }
     activities.clear();
 
-    // Set the size field in the header
-    static_cast<SyncQueue::Header*>(static_cast<void*>(buffer))->buffer_size = size + sizeof(SyncQueue::Header);
-    
-    return buffer;
+    // Set the size fields in the header
+    SyncQueue::Header* hdr = static_cast<SyncQueue::Header*>(static_cast<void*>(buffer));
+    hdr->buffer_size = size + sizeof(SyncQueue::Header);
+    hdr->uncompressed_size = size;
+
+    if ( compress_threshold == 0 || size < compress_threshold ) {
+        return buffer;
+    }
+
+    auto compressStart = SST::Core::Profile::now();
+
+    size_t bound = Core::Compress::lzCompressBound(size) + sizeof(SyncQueue::Header);
+    if ( cbuf_size < bound ) {
+        delete[] cbuffer;
+        cbuf_size = growBufferSize(cbuf_size, bound);
+        cbuffer = new char[cbuf_size];
+    }
+
+    size_t csize = Core::Compress::lzCompress(buffer + sizeof(SyncQueue::Header), size,
+                                              cbuffer + sizeof(SyncQueue::Header), cbuf_size - sizeof(SyncQueue::Header));
+
+    compress_time += SST::Core::Profile::getElapsed(compressStart);
+
+    // Only send the compressed version if it is actually smaller
+    if ( csize == 0 || csize >= size ) {
+        return buffer;
+    }
+
+    ::memcpy(cbuffer, buffer, sizeof(SyncQueue::Header));
+    static_cast<SyncQueue::Header*>(static_cast<void*>(cbuffer))->buffer_size = csize + sizeof(SyncQueue::Header);
+    compress_saved += size - csize;
+
+    return cbuffer;
+}
+
+char*
+SyncQueue::getPayload(char* buffer, std::vector<char>& scratch, size_t& size)
+{
+    SyncQueue::Header* hdr = reinterpret_cast<SyncQueue::Header*>(buffer);
+    size_t wire_size = hdr->buffer_size - sizeof(SyncQueue::Header);
+    size = hdr->uncompressed_size;
+    if ( wire_size == size ) {
+        return buffer + sizeof(SyncQueue::Header);
+    }
+
+    if ( scratch.size() < size ) scratch.resize(size);
+    if ( Core::Compress::lzDecompress(buffer + sizeof(SyncQueue::Header), wire_size, scratch.data(), size) != size ) {
+        Simulation::getSimulationOutput().fatal(CALL_INFO, 1, "Corrupt compressed sync buffer (%zu bytes, expected %zu after decompression)\n",
+                                                wire_size, size);
+    }
+    return scratch.data();
 }
 
 } // namespace SST
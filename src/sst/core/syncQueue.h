@@ -14,6 +14,7 @@
 
 //#include <sst/core/serialization.h>
 
+#include <cstdint>
 #include <vector>
 
 #include <sst/core/activityQueue.h>
@@ -34,10 +35,15 @@ public:
     struct Header {
         uint32_t mode;
         uint32_t count;
-        uint32_t buffer_size;
+        uint32_t buffer_size;       /*!< Bytes on the wire, including the header */
+        uint32_t uncompressed_size; /*!< Bytes of serialized data once decompressed */
     };
     
-    SyncQueue();
+    /**
+     * @param compress_threshold Serialized data at least this large is
+     * compressed before it is sent.  0 disables compression.
+     */
+    SyncQueue(uint64_t compress_threshold = 0);
     ~SyncQueue();
 
     bool empty() override;
@@ -53,14 +59,57 @@ public:
     char* getData();
 
     uint64_t getDataSize() {
-        return buf_size + (activities.capacity() * sizeof(Activity*));
+        return buf_size + cbuf_size + (activities.capacity() * sizeof(Activity*));
+    }
+
+    /** Bytes not sent because of compression */
+    uint64_t getCompressionSavings() const { return compress_saved; }
+    /** Time spent compressing (only tracked when profiling is enabled) */
+    double getCompressionTime() const { return compress_time; }
+
+    /**
+     * Returns a pointer to the serialized data in a buffer produced by
+     * getData() on the sending side.  If the sender compressed the
+     * data, it is decompressed into scratch.
+     * @param size Set to the number of bytes of serialized data
+     */
+    static char* getPayload(char* buffer, std::vector<char>& scratch, size_t& size);
+
+    /**
+     * Returns the size a sync buffer of current bytes should be grown
+     * to in order to hold needed bytes.  Buffers at least double so
+     * that slowly growing traffic does not cause a resize (and, across
+     * ranks, an extra resize message) on every sync.
+     */
+    static size_t growBufferSize(size_t current, size_t needed) {
+        if ( needed <= current ) return current;
+        size_t doubled = 2 * current;
+        return needed > doubled ? needed : doubled;
+    }
+
+    /**
+     * growBufferSize() for the buffer sizes exchanged between ranks,
+     * which are sent as 32 bit values.  The sender and receiver both
+     * apply this to track each other's buffer size.
+     */
+    static uint32_t growMessageSize(uint32_t current, uint32_t needed) {
+        if ( needed <= current ) return current;
+        uint64_t doubled = 2 * (uint64_t)current;
+        if ( doubled > UINT32_MAX ) doubled = UINT32_MAX;
+        return needed > doubled ? needed : (uint32_t)doubled;
     }
     
 private:
     char* buffer;
     size_t buf_size;
+    char* cbuffer;
+    size_t cbuf_size;
     std::vector<Activity*> activities;
 
+    uint64_t compress_threshold;
+    uint64_t compress_saved;
+    double compress_time;
+
     Core::ThreadSafe::Spinlock slock;
 };
 